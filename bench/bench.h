@@ -0,0 +1,35 @@
+// Copyright (c) 2013 Plenluno All rights reserved.
+
+#ifndef LIBJ_BENCH_BENCH_H_
+#define LIBJ_BENCH_BENCH_H_
+
+#include <libj/typedef.h>
+
+namespace libj {
+namespace bench {
+
+typedef void (*Function)(Size n);
+
+class Benchmark {
+ public:
+    Benchmark(const char* name, Function func, Size n);
+
+    static int runAll(const char* filter);
+};
+
+// keeps the compiler from optimizing away the measured code
+extern volatile Size sink;
+
+// the bytes processed by an iteration, set to report the throughput
+extern Size bytes;
+
+}  // namespace bench
+}  // namespace libj
+
+#define LIBJ_BENCH(G, N, ITERATIONS) \
+    static void libj_bench_##G##_##N(libj::Size n); \
+    static libj::bench::Benchmark libj_bench_reg_##G##_##N( \
+        #G "." #N, libj_bench_##G##_##N, ITERATIONS); \
+    static void libj_bench_##G##_##N(libj::Size n)
+
+#endif  // LIBJ_BENCH_BENCH_H_
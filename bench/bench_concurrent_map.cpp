@@ -0,0 +1,102 @@
+// Copyright (c) 2013 Plenluno All rights reserved.
+
+#include "./bench.h"
+
+#include <libj/concurrent_map.h>
+#include <libj/js_function.h>
+#include <libj/status.h>
+#include <libj/thread.h>
+#include <libj/bridge/abstract_map.h>
+#include <libj/detail/scoped_lock.h>
+
+#include <vector>
+
+namespace libj {
+
+static const Size N_THREADS = 16;
+static const Size N_KEYS = 10000;
+static const Size N_CONCURRENT_MAP = 10000000;
+
+// a Map under one lock, as ConcurrentMap was before the stripes
+class BenchLockedMap : public bridge::AbstractMap<Map> {
+ public:
+    virtual Value get(const Value& key) const {
+        detail::ScopedLock lock(mutex_);
+        return bridge::AbstractMap<Map>::get(key);
+    }
+
+    virtual Value put(const Value& key, const Value& val) {
+        detail::ScopedLock lock(mutex_);
+        return bridge::AbstractMap<Map>::put(key, val);
+    }
+
+#ifdef LIBJ_USE_CXX11
+    virtual Value put(Value&& key, Value&& val) {
+        detail::ScopedLock lock(mutex_);
+        return bridge::AbstractMap<Map>::put(std::move(key), std::move(val));
+    }
+#endif
+
+    virtual String::CPtr toString() const {
+        return String::create();
+    }
+
+ private:
+    mutable detail::Mutex mutex_;
+};
+
+// 9 gets to 1 put
+class BenchMapReader : LIBJ_JS_FUNCTION(BenchMapReader)
+ public:
+    BenchMapReader(Map::Ptr m, Size id, Size n)
+        : m_(m)
+        , id_(id)
+        , n_(n) {}
+
+    virtual Value operator()(JsArray::Ptr args) {
+        Size k = id_ * 7919;
+        for (Size i = 0; i < n_; i++) {
+            k = (k + 104729) % N_KEYS;
+            Long key = static_cast<Long>(k);
+            if (i % 10) {
+                bench::sink += m_->get(key).isUndefined();
+            } else {
+                m_->put(key, i);
+            }
+        }
+        return Status::OK;
+    }
+
+ private:
+    Map::Ptr m_;
+    Size id_;
+    Size n_;
+};
+
+static void readMostly(Map::Ptr m, Size n) {
+    for (Size i = 0; i < N_KEYS; i++) {
+        m->put(static_cast<Long>(i), i);
+    }
+
+    std::vector<Thread::Ptr> threads;
+    for (Size i = 0; i < N_THREADS; i++) {
+        threads.push_back(Thread::create(
+            Function::Ptr(new BenchMapReader(m, i, n / N_THREADS))));
+    }
+    for (Size i = 0; i < N_THREADS; i++) {
+        threads[i]->start();
+    }
+    for (Size i = 0; i < N_THREADS; i++) {
+        threads[i]->join();
+    }
+}
+
+LIBJ_BENCH(ConcurrentMap, ReadMostly16Threads, N_CONCURRENT_MAP) {
+    readMostly(ConcurrentMap::create(), n);
+}
+
+LIBJ_BENCH(LockedMap, ReadMostly16Threads, N_CONCURRENT_MAP) {
+    readMostly(Map::Ptr(new BenchLockedMap()), n);
+}
+
+}  // namespace libj
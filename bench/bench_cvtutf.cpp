@@ -0,0 +1,84 @@
+// Copyright (c) 2013 Plenluno All rights reserved.
+
+#include "./bench.h"
+
+#include <libj/string.h>
+#include <libj/glue/cvtutf.h>
+
+#include <string>
+
+namespace libj {
+
+static const Size N_CVTUTF = 1000;
+
+// about 64KB of text repeating unit
+static std::string text(const char* unit) {
+    std::string s8;
+    while (s8.length() < 65536) s8 += unit;
+    return s8;
+}
+
+static std::string ascii() {
+    return text("Content-Type: application/json; charset=utf-8\r\n");
+}
+
+static std::string mixed() {
+    return text("The caf\xc3\xa9 serves cr\xc3\xa8me br\xc3\xbbl\xc3\xa9""e, "
+                "\xe6\x97\xa5\xe6\x9c\xac too. ");
+}
+
+static std::string cjk() {
+    return text("\xe6\x97\xa5\xe6\x9c\xac\xe8\xaa\x9e\xe3\x81\xae"
+                "\xe3\x83\x86\xe3\x82\xad\xe3\x82\xb9\xe3\x83\x88\xe3\x80\x82");
+}
+
+static void utf8ToUtf16(const std::string& s8, Size n) {
+    bench::bytes = s8.length();
+    for (Size i = 0; i < n; i++) {
+        bench::sink += glue::utf8ToUtf16(s8).length();
+    }
+}
+
+static void utf16ToUtf8(const std::string& s8, Size n) {
+    std::u16string s16 = glue::utf8ToUtf16(s8);
+    bench::bytes = s8.length();
+    for (Size i = 0; i < n; i++) {
+        bench::sink += glue::utf16ToUtf8(s16).length();
+    }
+}
+
+LIBJ_BENCH(CvtUtf, Utf8ToUtf16Ascii, N_CVTUTF) {
+    utf8ToUtf16(ascii(), n);
+}
+
+LIBJ_BENCH(CvtUtf, Utf8ToUtf16Mixed, N_CVTUTF) {
+    utf8ToUtf16(mixed(), n);
+}
+
+LIBJ_BENCH(CvtUtf, Utf8ToUtf16Cjk, N_CVTUTF) {
+    utf8ToUtf16(cjk(), n);
+}
+
+LIBJ_BENCH(CvtUtf, Utf16ToUtf8Ascii, N_CVTUTF) {
+    utf16ToUtf8(ascii(), n);
+}
+
+LIBJ_BENCH(CvtUtf, Utf16ToUtf8Mixed, N_CVTUTF) {
+    utf16ToUtf8(mixed(), n);
+}
+
+LIBJ_BENCH(CvtUtf, Utf16ToUtf8Cjk, N_CVTUTF) {
+    utf16ToUtf8(cjk(), n);
+}
+
+// decodes into a String and encodes it back
+LIBJ_BENCH(CvtUtf, StringRoundTripMixed, N_CVTUTF) {
+    std::string s8 = mixed();
+    bench::bytes = s8.length();
+    for (Size i = 0; i < n; i++) {
+        String::CPtr s = String::create(s8.c_str(), String::UTF8);
+        bench::sink += s->toStdString().length();
+    }
+}
+
+}  // namespace libj
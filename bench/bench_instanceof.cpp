@@ -0,0 +1,128 @@
+// Copyright (c) 2013 Plenluno All rights reserved.
+
+#include "./bench.h"
+
+#include <libj/typed_js_array.h>
+#include <libj/value.h>
+
+namespace libj {
+
+// the recursive instanceof used before ancestries were introduced
+template<int N>
+class BenchChain : public BenchChain<N - 1> {
+ public:
+    virtual Boolean instanceof(TypeId id) const {
+        return id == Type<BenchChain>::id()
+            || BenchChain<N - 1>::instanceof(id);
+    }
+};
+
+template<>
+class BenchChain<0> {
+ public:
+    virtual ~BenchChain() {}
+
+    virtual Boolean instanceof(TypeId id) const {
+        return id == Type<BenchChain>::id();
+    }
+};
+
+// the same hierarchy using ancestries
+template<int N>
+class BenchAncestry : public BenchAncestry<N - 1> {
+ public:
+    virtual Boolean instanceof(TypeId id) const {
+        return id == Type<BenchAncestry>::id()
+            || detail::inAncestry(ancestry(), id);
+    }
+
+    LIBJ_ANCESTRY_DEF(BenchAncestry, BenchAncestry<N - 1>)
+};
+
+template<>
+class BenchAncestry<0> {
+ public:
+    virtual ~BenchAncestry() {}
+
+    virtual Boolean instanceof(TypeId id) const {
+        return id == Type<BenchAncestry>::id();
+    }
+
+    static const TypeId* ancestry() {
+        static const TypeId* a =
+            detail::createAncestry(Type<BenchAncestry>::id());
+        return a;
+    }
+};
+
+template<typename Base, typename Derived>
+static void instanceofLoop(Size n, TypeId id) {
+    // volatile prevents the call from being devirtualized and hoisted
+    const Base* volatile b = new Derived();
+    for (Size i = 0; i < n; i++) {
+        bench::sink += b->instanceof(id);
+    }
+    delete b;
+}
+
+static const Size N_INSTANCEOF = 10000000;
+
+LIBJ_BENCH(InstanceOf, Chain7Hit, N_INSTANCEOF) {
+    instanceofLoop<BenchChain<0>, BenchChain<6> >(
+        n, Type<BenchChain<1> >::id());
+}
+
+LIBJ_BENCH(InstanceOf, Ancestry7Hit, N_INSTANCEOF) {
+    instanceofLoop<BenchAncestry<0>, BenchAncestry<6> >(
+        n, Type<BenchAncestry<1> >::id());
+}
+
+LIBJ_BENCH(InstanceOf, Chain7Miss, N_INSTANCEOF) {
+    instanceofLoop<BenchChain<0>, BenchChain<6> >(n, Type<String>::id());
+}
+
+LIBJ_BENCH(InstanceOf, Ancestry7Miss, N_INSTANCEOF) {
+    instanceofLoop<BenchAncestry<0>, BenchAncestry<6> >(
+        n, Type<String>::id());
+}
+
+LIBJ_BENCH(InstanceOf, Chain16Miss, N_INSTANCEOF) {
+    instanceofLoop<BenchChain<0>, BenchChain<15> >(n, Type<String>::id());
+}
+
+LIBJ_BENCH(InstanceOf, Ancestry16Miss, N_INSTANCEOF) {
+    instanceofLoop<BenchAncestry<0>, BenchAncestry<15> >(
+        n, Type<String>::id());
+}
+
+LIBJ_BENCH(InstanceOf, TypedJsArrayHit, N_INSTANCEOF) {
+    Object::CPtr a = TypedJsArray<Int>::create();
+    TypeId id = Type<Mutable>::id();
+    for (Size i = 0; i < n; i++) {
+        bench::sink += a->instanceof(id);
+    }
+}
+
+LIBJ_BENCH(InstanceOf, TypedJsArrayMiss, N_INSTANCEOF) {
+    Object::CPtr a = TypedJsArray<Int>::create();
+    TypeId id = Type<String>::id();
+    for (Size i = 0; i < n; i++) {
+        bench::sink += a->instanceof(id);
+    }
+}
+
+LIBJ_BENCH(InstanceOf, ValueIsCollection, N_INSTANCEOF) {
+    Value v = TypedJsArray<Int>::create();
+    for (Size i = 0; i < n; i++) {
+        bench::sink += v.is<Collection>();
+    }
+}
+
+LIBJ_BENCH(InstanceOf, ToCPtrCollection, N_INSTANCEOF) {
+    Value v = TypedJsArray<Int>::create();
+    for (Size i = 0; i < n; i++) {
+        bench::sink += !!toCPtr<Collection>(v);
+    }
+}
+
+}  // namespace libj
@@ -0,0 +1,69 @@
+// Copyright (c) 2013 Plenluno All rights reserved.
+
+#include "./bench.h"
+
+#include <libj/detail/gc_collect.h>
+
+#include <stdio.h>
+#include <string.h>
+#include <sys/time.h>
+
+#include <vector>
+
+namespace libj {
+namespace bench {
+
+volatile Size sink = 0;
+
+Size bytes = 0;
+
+struct Entry {
+    const char* name;
+    Function func;
+    Size n;
+};
+
+static std::vector<Entry>& entries() {
+    static std::vector<Entry> es;
+    return es;
+}
+
+static Double now() {
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return tv.tv_sec * 1e9 + tv.tv_usec * 1e3;
+}
+
+Benchmark::Benchmark(const char* name, Function func, Size n) {
+    Entry e = { name, func, n };
+    entries().push_back(e);
+}
+
+int Benchmark::runAll(const char* filter) {
+    std::vector<Entry>& es = entries();
+    for (Size i = 0; i < es.size(); i++) {
+        const Entry& e = es[i];
+        if (filter && !strstr(e.name, filter)) continue;
+
+        bytes = 0;
+        Double start = now();
+        e.func(e.n);
+        Double elapsed = now() - start;
+        LIBJ_GC_COLLECT;
+
+        printf("%-48s %12.2f ns/op %10.2f ms",
+            e.name, elapsed / e.n, elapsed / 1e6);
+        if (bytes) {
+            printf(" %10.2f MB/s", bytes * 1e3 * e.n / elapsed);
+        }
+        printf("\n");
+    }
+    return 0;
+}
+
+}  // namespace bench
+}  // namespace libj
+
+int main(int argc, char** argv) {
+    return libj::bench::Benchmark::runAll(argc > 1 ? argv[1] : NULL);
+}
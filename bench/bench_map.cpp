@@ -0,0 +1,198 @@
+// Copyright (c) 2013 Plenluno All rights reserved.
+
+#include "./bench.h"
+
+#include <libj/hash_map.h>
+#include <libj/js_object.h>
+#include <libj/map.h>
+#include <libj/string.h>
+
+#include <vector>
+
+namespace libj {
+
+static const Size N_MAP = 1000000;
+
+static void putLongs(Map::Ptr m, Size size, Size n) {
+    for (Size i = 0; i < n; i++) {
+        if (i % size == 0) m->clear();
+        m->put(static_cast<Long>(i % size), i);
+    }
+    bench::sink += m->size();
+}
+
+static void getLongs(Map::Ptr m, Size size, Size n) {
+    for (Size i = 0; i < size; i++) {
+        m->put(static_cast<Long>(i), i);
+    }
+    for (Size i = 0; i < n; i++) {
+        Long key = static_cast<Long>((i * 7919) % size);
+        bench::sink += m->get(key).isUndefined();
+    }
+}
+
+static void getStrings(Map::Ptr m, Size size, Size n) {
+    std::vector<String::CPtr> keys;
+    for (Size i = 0; i < size; i++) {
+        keys.push_back(String::valueOf(static_cast<Long>(i)));
+        m->put(keys.back(), i);
+    }
+    // equal but not identical keys, as parsed from input
+    std::vector<String::CPtr> probes;
+    for (Size i = 0; i < size; i++) {
+        probes.push_back(String::create(keys[i]->toStdString().c_str()));
+    }
+    for (Size i = 0; i < n; i++) {
+        bench::sink += m->get(probes[(i * 7919) % size]).isUndefined();
+    }
+}
+
+LIBJ_BENCH(Map, PutLong1K, N_MAP) {
+    putLongs(Map::create(), 1000, n);
+}
+
+LIBJ_BENCH(HashMap, PutLong1K, N_MAP) {
+    putLongs(HashMap::create(), 1000, n);
+}
+
+LIBJ_BENCH(Map, GetLong1K, N_MAP) {
+    getLongs(Map::create(), 1000, n);
+}
+
+LIBJ_BENCH(HashMap, GetLong1K, N_MAP) {
+    getLongs(HashMap::create(), 1000, n);
+}
+
+LIBJ_BENCH(Map, GetLong100K, N_MAP) {
+    getLongs(Map::create(), 100000, n);
+}
+
+LIBJ_BENCH(HashMap, GetLong100K, N_MAP) {
+    getLongs(HashMap::create(), 100000, n);
+}
+
+LIBJ_BENCH(Map, GetString1K, N_MAP) {
+    getStrings(Map::create(), 1000, n);
+}
+
+LIBJ_BENCH(HashMap, GetString1K, N_MAP) {
+    getStrings(HashMap::create(), 1000, n);
+}
+
+LIBJ_BENCH(Map, GetString100K, N_MAP) {
+    getStrings(Map::create(), 100000, n);
+}
+
+LIBJ_BENCH(HashMap, GetString100K, N_MAP) {
+    getStrings(HashMap::create(), 100000, n);
+}
+
+// the maps are filled in the measured time, and as many keys are looked up
+// as are put, so that an op of the following is a put and a get.
+// 10M string keys, with their probes, need several GB and are left out.
+
+LIBJ_BENCH(Map, PutGetLong1M, N_MAP) {
+    getLongs(Map::create(), 1000000, n);
+}
+
+LIBJ_BENCH(HashMap, PutGetLong1M, N_MAP) {
+    getLongs(HashMap::create(), 1000000, n);
+}
+
+LIBJ_BENCH(Map, PutGetLong10M, N_MAP * 10) {
+    getLongs(Map::create(), 10000000, n);
+}
+
+LIBJ_BENCH(HashMap, PutGetLong10M, N_MAP * 10) {
+    getLongs(HashMap::create(), 10000000, n);
+}
+
+LIBJ_BENCH(Map, PutGetString1M, N_MAP) {
+    getStrings(Map::create(), 1000000, n);
+}
+
+LIBJ_BENCH(HashMap, PutGetString1M, N_MAP) {
+    getStrings(HashMap::create(), 1000000, n);
+}
+
+// put(const Value&, const Value&), without the moves of temporaries
+static void putStrings(Map::Ptr m, Size size, Size n) {
+    std::vector<Value> keys;
+    for (Size i = 0; i < size; i++) {
+        keys.push_back(String::valueOf(static_cast<Long>(i)));
+    }
+    Value val = 1;
+    for (Size i = 0; i < n; i++) {
+        if (i % size == 0) m->clear();
+        m->put(keys[i % size], val);
+    }
+    bench::sink += m->size();
+}
+
+LIBJ_BENCH(Map, PutString1K, N_MAP) {
+    putStrings(Map::create(), 1000, n);
+}
+
+LIBJ_BENCH(HashMap, PutString1K, N_MAP) {
+    putStrings(HashMap::create(), 1000, n);
+}
+
+static void putAllSorted(Map::Ptr m, Size size, Size n) {
+    Map::Ptr src = Map::create();
+    for (Size i = 0; i < size; i++) {
+        src->put(static_cast<Long>(i), i);
+    }
+    for (Size i = 0; i < n; i += size) {
+        m->clear();
+        m->putAll(src);
+        bench::sink += m->size();
+    }
+}
+
+LIBJ_BENCH(Map, PutAllSorted100K, N_MAP) {
+    putAllSorted(Map::create(), 100000, n);
+}
+
+LIBJ_BENCH(HashMap, PutAllSorted100K, N_MAP) {
+    putAllSorted(HashMap::create(), 100000, n);
+}
+
+// the objects of the same schema, as parsed from JSON
+LIBJ_BENCH(JsObject, Create8, N_MAP / 10) {
+    std::vector<String::CPtr> keys;
+    for (Size i = 0; i < 8; i++) {
+        keys.push_back(String::valueOf(static_cast<Long>(i * 1000)));
+    }
+    for (Size i = 0; i < n; i++) {
+        JsObject::Ptr obj = JsObject::create();
+        for (Size j = 0; j < 8; j++) {
+            obj->put(keys[j], j);
+        }
+        bench::sink += obj->size();
+    }
+}
+
+LIBJ_BENCH(JsObject, GetProperty8, N_MAP) {
+    std::vector<String::CPtr> keys;
+    JsObject::Ptr obj = JsObject::create();
+    for (Size i = 0; i < 8; i++) {
+        keys.push_back(String::valueOf(static_cast<Long>(i * 1000)));
+        obj->put(keys.back(), i);
+    }
+    for (Size i = 0; i < n; i++) {
+        bench::sink += obj->getProperty(keys[i % 8]).isUndefined();
+    }
+}
+
+LIBJ_BENCH(JsObject, GetPropertyKey8, N_MAP * 10) {
+    LIBJ_STATIC_JS_PROPERTY_KEY_DEF(key, "5000");
+    JsObject::Ptr obj = JsObject::create();
+    for (Size i = 0; i < 8; i++) {
+        obj->put(String::valueOf(static_cast<Long>(i * 1000)), i);
+    }
+    for (Size i = 0; i < n; i++) {
+        bench::sink += obj->getProperty(key).isUndefined();
+    }
+}
+
+}  // namespace libj
@@ -0,0 +1,84 @@
+// Copyright (c) 2013 Plenluno All rights reserved.
+
+#include "./bench.h"
+
+#include <libj/js_array.h>
+#include <libj/mutable.h>
+#include <libj/string.h>
+#include <libj/this.h>
+
+namespace libj {
+
+class BenchPointer : LIBJ_MUTABLE(BenchPointer)
+ public:
+    static Ptr create() {
+        return Ptr(new BenchPointer());
+    }
+
+    Ptr thisPtr() {
+        return LIBJ_THIS_PTR(BenchPointer);
+    }
+
+    virtual String::CPtr toString() const {
+        return String::create();
+    }
+};
+
+static const Size N_POINTER = 10000000;
+
+LIBJ_BENCH(Pointer, Create, N_POINTER) {
+    for (Size i = 0; i < n; i++) {
+        BenchPointer::Ptr p = BenchPointer::create();
+        bench::sink += !!p;
+    }
+}
+
+LIBJ_BENCH(Pointer, Copy, N_POINTER) {
+    BenchPointer::Ptr p = BenchPointer::create();
+    for (Size i = 0; i < n; i++) {
+        BenchPointer::Ptr q = p;
+        bench::sink += !!q;
+    }
+}
+
+LIBJ_BENCH(Pointer, UpCast, N_POINTER) {
+    BenchPointer::Ptr p = BenchPointer::create();
+    for (Size i = 0; i < n; i++) {
+        Object::CPtr q = p;
+        bench::sink += !!q;
+    }
+}
+
+LIBJ_BENCH(Pointer, ThisPtr, N_POINTER) {
+    BenchPointer::Ptr p = BenchPointer::create();
+    for (Size i = 0; i < n; i++) {
+        BenchPointer::Ptr q = p->thisPtr();
+        bench::sink += !!q;
+    }
+}
+
+LIBJ_BENCH(Pointer, ValueToCPtr, N_POINTER) {
+    Value v = BenchPointer::create();
+    for (Size i = 0; i < n; i++) {
+        BenchPointer::CPtr q = toCPtr<BenchPointer>(v);
+        bench::sink += !!q;
+    }
+}
+
+static const Size N_ELEMENTS = 1000;
+
+LIBJ_BENCH(Pointer, IterateJsArray, N_POINTER / N_ELEMENTS) {
+    JsArray::Ptr a = JsArray::create();
+    for (Size i = 0; i < N_ELEMENTS; i++) {
+        a->add(BenchPointer::create());
+    }
+    for (Size i = 0; i < n; i++) {
+        Iterator::Ptr itr = a->iterator();
+        while (itr->hasNext()) {
+            BenchPointer::CPtr p = toCPtr<BenchPointer>(itr->next());
+            bench::sink += !!p;
+        }
+    }
+}
+
+}  // namespace libj
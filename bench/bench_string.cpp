@@ -0,0 +1,297 @@
+// Copyright (c) 2013 Plenluno All rights reserved.
+
+#include "./bench.h"
+
+#include <libj/js_array.h>
+#include <libj/json.h>
+#include <libj/string.h>
+#include <libj/string_searcher.h>
+
+#include <stdlib.h>
+
+#include <string>
+#include <vector>
+
+namespace libj {
+
+static const Size N_STRING = 1000000;
+
+LIBJ_BENCH(String, CreateShortAscii, N_STRING) {
+    for (Size i = 0; i < n; i++) {
+        String::CPtr s = String::create("content-type");
+        bench::sink += s->length();
+    }
+}
+
+LIBJ_BENCH(String, CreateLongAscii, N_STRING) {
+    std::string s8(200, 'x');
+    for (Size i = 0; i < n; i++) {
+        String::CPtr s = String::create(s8.c_str());
+        bench::sink += s->length();
+    }
+}
+
+LIBJ_BENCH(String, EqualsShort, N_STRING * 10) {
+    String::CPtr s1 = String::create("content-type");
+    String::CPtr s2 = String::create("content-typf");
+    for (Size i = 0; i < n; i++) {
+        bench::sink += s1->equals(s2);
+    }
+}
+
+// the hash codes of both strings are already computed
+LIBJ_BENCH(String, EqualsLongHashed, N_STRING) {
+    std::string s8(200, 'x');
+    String::CPtr s1 = String::create((s8 + "y").c_str());
+    String::CPtr s2 = String::create((s8 + "z").c_str());
+    s1->hashCode();
+    s2->hashCode();
+    for (Size i = 0; i < n; i++) {
+        bench::sink += s1->equals(s2);
+    }
+}
+
+LIBJ_BENCH(String, Intern, N_STRING) {
+    std::vector<String::CPtr> keys;
+    for (Size i = 0; i < 1000; i++) {
+        keys.push_back(String::valueOf(static_cast<Long>(i)));
+    }
+    for (Size i = 0; i < n; i++) {
+        bench::sink += !!String::intern(keys[i % 1000]);
+    }
+}
+
+LIBJ_BENCH(String, CompareToLong, N_STRING) {
+    std::string s8(200, 'x');
+    String::CPtr s1 = String::create(s8.c_str());
+    String::CPtr s2 = s1->concat(String::create("y"));
+    for (Size i = 0; i < n; i++) {
+        bench::sink += s1->compareTo(s2);
+    }
+}
+
+LIBJ_BENCH(String, CharAt, N_STRING * 10) {
+    String::CPtr s = String::create("abcdefghijklmnopqrstuvwxyz");
+    Size len = s->length();
+    for (Size i = 0; i < n; i++) {
+        bench::sink += s->charAt(i % len);
+    }
+}
+
+LIBJ_BENCH(String, IndexOfChar, N_STRING) {
+    std::string s8(1000, 'x');
+    String::CPtr s = String::create((s8 + "y").c_str());
+    for (Size i = 0; i < n; i++) {
+        bench::sink += s->indexOf('y');
+    }
+}
+
+LIBJ_BENCH(String, IndexOfCharWide, N_STRING) {
+    std::string s8(1000, 'x');
+    String::CPtr s = String::create(("\xe6\x97\xa5" + s8 + "y").c_str());
+    for (Size i = 0; i < n; i++) {
+        bench::sink += s->indexOf('y');
+    }
+}
+
+LIBJ_BENCH(String, LastIndexOfChar, N_STRING) {
+    std::string s8(1000, 'x');
+    String::CPtr s = String::create(("y" + s8).c_str());
+    for (Size i = 0; i < n; i++) {
+        bench::sink += s->lastIndexOf('y');
+    }
+}
+
+LIBJ_BENCH(String, ReplaceChar, N_STRING / 10) {
+    std::string s8(1000, 'x');
+    String::CPtr s = String::create(("-" + s8).c_str());
+    for (Size i = 0; i < n; i++) {
+        bench::sink += s->replace('x', 'y')->length();
+    }
+}
+
+// normalizes header names
+LIBJ_BENCH(String, ToLowerCase, N_STRING) {
+    String::CPtr s = String::create("X-Forwarded-For-Content-Type-Options");
+    for (Size i = 0; i < n; i++) {
+        bench::sink += s->toLowerCase()->length();
+    }
+}
+
+LIBJ_BENCH(String, ToUpperCaseLong, N_STRING / 10) {
+    std::string s8(1000, 'x');
+    String::CPtr s = String::create(s8.c_str());
+    for (Size i = 0; i < n; i++) {
+        bench::sink += s->toUpperCase()->length();
+    }
+}
+
+LIBJ_BENCH(String, IndexOfString, N_STRING / 10) {
+    std::string s8(1000, 'x');
+    String::CPtr s = String::create((s8 + "xyz").c_str());
+    String::CPtr pat = String::create("xyz");
+    for (Size i = 0; i < n; i++) {
+        bench::sink += s->indexOf(pat);
+    }
+}
+
+LIBJ_BENCH(String, IndexOfLongString, N_STRING / 10) {
+    std::string s8;
+    while (s8.length() < 1000) s8 += "content-type: text/plain; ";
+    String::CPtr s = String::create((s8 + "charset=utf-8").c_str());
+    String::CPtr pat = String::create("charset=utf-8");
+    for (Size i = 0; i < n; i++) {
+        bench::sink += s->indexOf(pat);
+    }
+}
+
+// finds a boundary in many short parts
+LIBJ_BENCH(String, StringSearcher, N_STRING / 10) {
+    std::string s8(100, 'x');
+    String::CPtr s = String::create((s8 + "--boundary").c_str());
+    StringSearcher::CPtr searcher =
+        StringSearcher::create(String::create("--boundary"));
+    for (Size i = 0; i < n; i++) {
+        bench::sink += searcher->search(s);
+    }
+}
+
+LIBJ_BENCH(String, ReplaceString, N_STRING / 100) {
+    std::string s8;
+    while (s8.length() < 1000) s8 += "content-type: text/plain; ";
+    String::CPtr s = String::create(s8.c_str());
+    String::CPtr oldS = String::create("text/plain");
+    String::CPtr newS = String::create("text/html");
+    for (Size i = 0; i < n; i++) {
+        bench::sink += s->replace(oldS, newS)->length();
+    }
+}
+
+LIBJ_BENCH(String, Concat, N_STRING) {
+    String::CPtr s1 = String::create("content-");
+    String::CPtr s2 = String::create("type");
+    for (Size i = 0; i < n; i++) {
+        bench::sink += s1->concat(s2)->length();
+    }
+}
+
+LIBJ_BENCH(String, Substring, N_STRING) {
+    std::string s8(1000, 'x');
+    String::CPtr s = String::create(s8.c_str());
+    for (Size i = 0; i < n; i++) {
+        bench::sink += s->substring(i % 100, 900)->length();
+    }
+}
+
+// scans a long input the way a global regexp does
+LIBJ_BENCH(String, SubstringScan, 10) {
+    std::string s8(10000, 'x');
+    String::CPtr s = String::create(s8.c_str());
+    for (Size i = 0; i < n; i++) {
+        for (Size j = 0; j < 10000; j += 10) {
+            bench::sink += s->substring(j)->charAt(0);
+        }
+    }
+}
+
+// splits a CSV line of 100 fields
+LIBJ_BENCH(String, SplitChar, N_STRING / 100) {
+    JsArray::Ptr fields = JsArray::create();
+    for (Size i = 0; i < 100; i++) {
+        fields->add(i * 7919);
+    }
+    String::CPtr line = fields->join();
+    for (Size i = 0; i < n; i++) {
+        bench::sink += line->split(',')->length();
+    }
+}
+
+// the loop split replaces
+LIBJ_BENCH(String, SplitByIndexOf, N_STRING / 100) {
+    JsArray::Ptr fields = JsArray::create();
+    for (Size i = 0; i < 100; i++) {
+        fields->add(i * 7919);
+    }
+    String::CPtr line = fields->join();
+    for (Size i = 0; i < n; i++) {
+        JsArray::Ptr a = JsArray::create();
+        Size prev = 0;
+        Size curr = line->indexOf(',');
+        while (curr != NO_POS) {
+            a->add(line->substring(prev, curr));
+            prev = curr + 1;
+            curr = line->indexOf(',', prev);
+        }
+        a->add(line->substring(prev));
+        bench::sink += a->length();
+    }
+}
+
+LIBJ_BENCH(String, Join, N_STRING / 100) {
+    JsArray::Ptr a = JsArray::create();
+    for (Size i = 0; i < 100; i++) {
+        a->add(String::create("field"));
+    }
+    String::CPtr sep = String::create(", ");
+    for (Size i = 0; i < n; i++) {
+        bench::sink += a->join(sep)->length();
+    }
+}
+
+// appends chunks the way the XML serializer does
+LIBJ_BENCH(String, ConcatLoop, 10) {
+    String::CPtr chunk = String::create(std::string(64, 'x').c_str());
+    for (Size i = 0; i < n; i++) {
+        String::CPtr s = String::create();
+        for (Size j = 0; j < 10000; j++) {
+            s = s->concat(chunk);
+        }
+        bench::sink += s->charAt(0);
+    }
+}
+
+static std::vector<String::CPtr> numbers(const char* format, Double scale) {
+    std::vector<String::CPtr> v;
+    char buf[64];
+    for (Size i = 0; i < 1000; i++) {
+        snprintf(buf, sizeof(buf), format, (i * 7919 + 13) * scale);
+        v.push_back(String::create(buf));
+    }
+    return v;
+}
+
+LIBJ_BENCH(String, ParseLong, N_STRING) {
+    std::vector<String::CPtr> v = numbers("%.0f", 1234567.0);
+    for (Size i = 0; i < n; i++) {
+        Long l = 0;
+        parseLong(v[i % 1000], &l);
+        bench::sink += static_cast<Size>(l);
+    }
+}
+
+LIBJ_BENCH(String, ParseFloat, N_STRING) {
+    std::vector<String::CPtr> v = numbers("%.17g", 0.0001234);
+    for (Size i = 0; i < n; i++) {
+        bench::sink += parseFloat(v[i % 1000]) > 1;
+    }
+}
+
+// the conversions available before parseFloat, for comparison
+LIBJ_BENCH(String, ParseFloatJson, N_STRING) {
+    std::vector<String::CPtr> v = numbers("%.17g", 0.0001234);
+    for (Size i = 0; i < n; i++) {
+        Double d = 0;
+        to<Double>(json::parse(v[i % 1000]), &d);
+        bench::sink += d > 1;
+    }
+}
+
+LIBJ_BENCH(String, ParseFloatStrtod, N_STRING) {
+    std::vector<String::CPtr> v = numbers("%.17g", 0.0001234);
+    for (Size i = 0; i < n; i++) {
+        std::string s = v[i % 1000]->toStdString();
+        bench::sink += strtod(s.c_str(), NULL) > 1;
+    }
+}
+
+}  // namespace libj
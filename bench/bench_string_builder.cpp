@@ -0,0 +1,79 @@
+// Copyright (c) 2013 Plenluno All rights reserved.
+
+#include "./bench.h"
+
+#include <libj/js_array.h>
+#include <libj/json.h>
+#include <libj/string_builder.h>
+#include <libj/symbol.h>
+
+namespace libj {
+
+static const Size N_STRING_BUILDER = 1000;
+
+// about 64KB of short strings and integers
+static void appendLines(StringBuilder::Ptr sb) {
+    LIBJ_STATIC_SYMBOL_DEF(symKey, "\"key\":");
+    for (Int i = 0; i < 4096; i++) {
+        sb->append(symKey);
+        sb->append(i);
+        sb->appendStr(",\n");
+    }
+}
+
+LIBJ_BENCH(StringBuilder, Append, N_STRING_BUILDER) {
+    for (Size i = 0; i < n; i++) {
+        StringBuilder::Ptr sb = StringBuilder::create();
+        appendLines(sb);
+        bench::sink += sb->length();
+    }
+}
+
+LIBJ_BENCH(StringBuilder, ToString, N_STRING_BUILDER) {
+    for (Size i = 0; i < n; i++) {
+        StringBuilder::Ptr sb = StringBuilder::create();
+        appendLines(sb);
+        bench::sink += sb->toString()->length();
+    }
+}
+
+LIBJ_BENCH(StringBuilder, Build, N_STRING_BUILDER) {
+    for (Size i = 0; i < n; i++) {
+        StringBuilder::Ptr sb = StringBuilder::create();
+        appendLines(sb);
+        bench::sink += sb->build()->length();
+    }
+}
+
+LIBJ_BENCH(StringBuilder, AppendLong, N_STRING_BUILDER) {
+    for (Size i = 0; i < n; i++) {
+        StringBuilder::Ptr sb = StringBuilder::create();
+        for (Long j = 0; j < 4096; j++) {
+            sb->append(j * 1000003);
+        }
+        bench::sink += sb->length();
+    }
+}
+
+// the doubles holding integers, such as the ones parsed from JSON
+LIBJ_BENCH(StringBuilder, AppendIntegralDouble, N_STRING_BUILDER) {
+    for (Size i = 0; i < n; i++) {
+        StringBuilder::Ptr sb = StringBuilder::create();
+        for (Int j = 0; j < 4096; j++) {
+            sb->append(static_cast<Double>(j));
+        }
+        bench::sink += sb->length();
+    }
+}
+
+LIBJ_BENCH(StringBuilder, StringifyArray, N_STRING_BUILDER) {
+    JsArray::Ptr a = JsArray::create();
+    for (Int i = 0; i < 10000; i++) {
+        a->add(i);
+    }
+    for (Size i = 0; i < n; i++) {
+        bench::sink += json::stringify(a)->length();
+    }
+}
+
+}  // namespace libj
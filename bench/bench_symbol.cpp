@@ -0,0 +1,96 @@
+// Copyright (c) 2013 Plenluno All rights reserved.
+
+#include "./bench.h"
+
+#include <libj/string.h>
+#include <libj/symbol.h>
+
+#ifdef LIBJ_USE_THREAD
+# include <libj/js_array.h>
+# include <libj/js_function.h>
+# include <libj/thread.h>
+# include <vector>
+#endif
+
+namespace libj {
+
+static const Size N_SYMBOL = 1000000;
+
+LIBJ_BENCH(Symbol, Create, N_SYMBOL) {
+    for (Size i = 0; i < n; i++) {
+        LIBJ_SYMBOL_DEF(sym, "content-type");
+        bench::sink += sym->length();
+    }
+}
+
+// interns keys that are dropped right away, like parsed JSON keys
+LIBJ_BENCH(Symbol, InternWeak, N_SYMBOL) {
+    for (Size i = 0; i < n; i++) {
+        String::CPtr s = String::valueOf(static_cast<Long>(i));
+        bench::sink += String::intern(s, true)->length();
+    }
+}
+
+#ifdef LIBJ_USE_THREAD
+
+static const Size N_KEYS = 1000;
+
+static JsArray::Ptr createKeys(Size offset) {
+    JsArray::Ptr keys = JsArray::create();
+    for (Size i = 0; i < N_KEYS; i++) {
+        keys->add(String::valueOf(static_cast<Long>(offset + i)));
+    }
+    return keys;
+}
+
+class BenchSymbolIntern : LIBJ_JS_FUNCTION(BenchSymbolIntern)
+ public:
+    BenchSymbolIntern(JsArray::Ptr keys, Size n) : keys_(keys), n_(n) {}
+
+    virtual Value operator()(JsArray::Ptr args) {
+        std::vector<String::CPtr> keys;
+        for (Size i = 0; i < N_KEYS; i++) {
+            keys.push_back(keys_->getCPtr<String>(i));
+        }
+        for (Size i = 0; i < n_; i++) {
+            bench::sink += String::intern(keys[i % N_KEYS])->length();
+        }
+        return UNDEFINED;
+    }
+
+ private:
+    JsArray::Ptr keys_;
+    Size n_;
+};
+
+// each thread looks up n / numThreads symbols
+static void internInThreads(Size numThreads, Size n) {
+    JsArray::Ptr threads = JsArray::create();
+    for (Size i = 0; i < numThreads; i++) {
+        Function::Ptr f(new BenchSymbolIntern(
+            createKeys(i * N_KEYS), n / numThreads));
+        threads->add(Thread::create(f));
+    }
+    for (Size i = 0; i < numThreads; i++) {
+        threads->getPtr<Thread>(i)->start();
+    }
+    for (Size i = 0; i < numThreads; i++) {
+        threads->getPtr<Thread>(i)->join();
+    }
+}
+
+LIBJ_BENCH(Symbol, Intern1Thread, N_SYMBOL * 4) {
+    internInThreads(1, n);
+}
+
+LIBJ_BENCH(Symbol, Intern4Threads, N_SYMBOL * 4) {
+    internInThreads(4, n);
+}
+
+LIBJ_BENCH(Symbol, Intern8Threads, N_SYMBOL * 4) {
+    internInThreads(8, n);
+}
+
+#endif  // LIBJ_USE_THREAD
+
+}  // namespace libj
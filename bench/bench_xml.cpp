@@ -0,0 +1,32 @@
+// Copyright (c) 2013 Plenluno All rights reserved.
+
+#include "./bench.h"
+
+#include <libj/string_builder.h>
+#include <libj/xml.h>
+
+namespace libj {
+
+static xml::Document::CPtr createDocument(Size items) {
+    StringBuilder::Ptr sb = StringBuilder::create();
+    sb->appendStr("<items>");
+    for (Size i = 0; i < items; i++) {
+        sb->appendStr("<item id=\"");
+        sb->append(i);
+        sb->appendStr("\"><name>item</name><value>");
+        sb->append(i * 3);
+        sb->appendStr("</value></item>");
+    }
+    sb->appendStr("</items>");
+    return xml::Document::parse(sb->toString());
+}
+
+LIBJ_BENCH(Xml, Serialize, 10) {
+    xml::Document::CPtr doc = createDocument(20000);
+    for (Size i = 0; i < n; i++) {
+        String::CPtr s = doc->toString();
+        bench::sink += s->charAt(0);
+    }
+}
+
+}  // namespace libj
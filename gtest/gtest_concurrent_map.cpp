@@ -2,6 +2,9 @@
 
 #include <gtest/gtest.h>
 #include <libj/concurrent_map.h>
+#include <libj/js_function.h>
+#include <libj/status.h>
+#include <libj/thread.h>
 
 namespace libj {
 
@@ -158,8 +161,261 @@ TEST(GTestConcurrentMap, TestToString) {
     m->put(y, String::null());
     m->put(String::null(), z);
     m->put(UNDEFINED, UNDEFINED);
-    ASSERT_TRUE(m->toString()->equals(
-        String::create("{undefined=undefined, null=z, x=123, y=null}")));
+    String::CPtr s = m->toString();
+    ASSERT_EQ(String::create("{undefined=undefined, null=z, x=123, y=null}")
+        ->length(), s->length());
+    ASSERT_TRUE(s->startsWith(String::create("{")));
+    ASSERT_NE(NO_POS, s->indexOf(String::create("undefined=undefined")));
+    ASSERT_NE(NO_POS, s->indexOf(String::create("null=z")));
+    ASSERT_NE(NO_POS, s->indexOf(String::create("x=123")));
+    ASSERT_NE(NO_POS, s->indexOf(String::create("y=null")));
+}
+
+TEST(GTestConcurrentMap, TestPutAll) {
+    ConcurrentMap::Ptr m = ConcurrentMap::create();
+    m->put(String::create("x"), 1);
+
+    Map::Ptr m2 = Map::create();
+    m2->put(String::create("x"), 2);
+    m2->put(String::create("y"), 3);
+
+    m->putAll(m2);
+    ASSERT_EQ(2, m->size());
+    ASSERT_TRUE(m->get(String::create("x")).equals(2));
+    ASSERT_TRUE(m->get(String::create("y")).equals(3));
+}
+
+class GTestConcurrentMapSum : LIBJ_JS_FUNCTION(GTestConcurrentMapSum)
+ public:
+    virtual Value operator()(JsArray::Ptr args) {
+        Int sum = to<Int>(args->get(0)) + to<Int>(args->get(1));
+        if (sum) {
+            return sum;
+        } else {
+            return UNDEFINED;
+        }
+    }
+};
+
+class GTestConcurrentMapCount : LIBJ_JS_FUNCTION(GTestConcurrentMapCount)
+ public:
+    GTestConcurrentMapCount(Value result) : count_(0), result_(result) {}
+
+    virtual Value operator()(JsArray::Ptr args) {
+        count_++;
+        return result_;
+    }
+
+    Int count() const {
+        return count_;
+    }
+
+ private:
+    Int count_;
+    Value result_;
+};
+
+TEST(GTestConcurrentMap, TestPutIfAbsent) {
+    ConcurrentMap::Ptr m = ConcurrentMap::create();
+    String::CPtr x = String::create("x");
+    ASSERT_TRUE(m->putIfAbsent(x, 1).isUndefined());
+    ASSERT_TRUE(m->putIfAbsent(x, 2).equals(1));
+    ASSERT_TRUE(m->get(x).equals(1));
+    ASSERT_EQ(1, m->size());
+}
+
+TEST(GTestConcurrentMap, TestReplace) {
+    ConcurrentMap::Ptr m = ConcurrentMap::create();
+    String::CPtr x = String::create("x");
+    ASSERT_FALSE(m->replace(x, UNDEFINED, 1));
+    ASSERT_FALSE(m->containsKey(x));
+
+    m->put(x, 1);
+    ASSERT_FALSE(m->replace(x, 2, 3));
+    ASSERT_TRUE(m->get(x).equals(1));
+    ASSERT_TRUE(m->replace(x, 1, 3));
+    ASSERT_TRUE(m->get(x).equals(3));
+}
+
+TEST(GTestConcurrentMap, TestComputeIfAbsent) {
+    ConcurrentMap::Ptr m = ConcurrentMap::create();
+    String::CPtr x = String::create("x");
+    GTestConcurrentMapCount::Ptr f(new GTestConcurrentMapCount(5));
+    ASSERT_TRUE(m->computeIfAbsent(x, f).equals(5));
+    ASSERT_TRUE(m->computeIfAbsent(x, f).equals(5));
+    ASSERT_EQ(1, f->count());
+    ASSERT_TRUE(m->get(x).equals(5));
+
+    String::CPtr y = String::create("y");
+    GTestConcurrentMapCount::Ptr g(new GTestConcurrentMapCount(UNDEFINED));
+    ASSERT_TRUE(m->computeIfAbsent(y, g).isUndefined());
+    ASSERT_EQ(1, g->count());
+    ASSERT_FALSE(m->containsKey(y));
+}
+
+TEST(GTestConcurrentMap, TestMerge) {
+    ConcurrentMap::Ptr m = ConcurrentMap::create();
+    String::CPtr x = String::create("x");
+    Function::Ptr sum(new GTestConcurrentMapSum());
+    ASSERT_TRUE(m->merge(x, 1, sum).equals(1));
+    ASSERT_TRUE(m->merge(x, 2, sum).equals(3));
+    ASSERT_TRUE(m->get(x).equals(3));
+    ASSERT_TRUE(m->merge(x, -3, sum).isUndefined());
+    ASSERT_FALSE(m->containsKey(x));
+}
+
+class GTestConcurrentMapPut : LIBJ_JS_FUNCTION(GTestConcurrentMapPut)
+ public:
+    GTestConcurrentMapPut(
+        ConcurrentMap::Ptr m,
+        Int id)
+        : id_(id)
+        , m_(m) {}
+
+    virtual Value operator()(JsArray::Ptr args) {
+        for (Int i = 0; i < 1000; i++) {
+            Long key = id_ * 1000 + i;
+            m_->put(key, i);
+            m_->get(key - 1);
+            if (i % 2) m_->remove(key);
+        }
+        return Status::OK;
+    }
+
+ private:
+    Int id_;
+    ConcurrentMap::Ptr m_;
+};
+
+class GTestConcurrentMapMerge : LIBJ_JS_FUNCTION(GTestConcurrentMapMerge)
+ public:
+    GTestConcurrentMapMerge(
+        ConcurrentMap::Ptr m,
+        Function::Ptr sum)
+        : m_(m)
+        , sum_(sum) {}
+
+    virtual Value operator()(JsArray::Ptr args) {
+        for (Int i = 0; i < 1000; i++) {
+            m_->merge(static_cast<Long>(i % 10), 1, sum_);
+        }
+        return Status::OK;
+    }
+
+ private:
+    ConcurrentMap::Ptr m_;
+    Function::Ptr sum_;
+};
+
+class GTestConcurrentMapIterate : LIBJ_JS_FUNCTION(GTestConcurrentMapIterate)
+ public:
+    GTestConcurrentMapIterate(ConcurrentMap::Ptr m) : m_(m) {}
+
+    virtual Value operator()(JsArray::Ptr args) {
+        for (Int i = 0; i < 100; i++) {
+            Iterator::Ptr itr = m_->keySet()->iterator();
+            while (itr->hasNext()) itr->next();
+        }
+        return Status::OK;
+    }
+
+ private:
+    ConcurrentMap::Ptr m_;
+};
+
+class GTestConcurrentMapPutAll : LIBJ_JS_FUNCTION(GTestConcurrentMapPutAll)
+ public:
+    GTestConcurrentMapPutAll(ConcurrentMap::Ptr m, Map::CPtr src)
+        : m_(m)
+        , src_(src) {}
+
+    virtual Value operator()(JsArray::Ptr args) {
+        m_->putAll(src_);
+        return Status::OK;
+    }
+
+ private:
+    ConcurrentMap::Ptr m_;
+    Map::CPtr src_;
+};
+
+TEST(GTestConcurrentMap, TestConcurrentAccess) {
+    const Int n = 4;
+    ConcurrentMap::Ptr m = ConcurrentMap::create();
+
+    JsArray::Ptr threads = JsArray::create();
+    for (Int i = 0; i < n; i++) {
+        threads->add(Thread::create(
+            Function::Ptr(new GTestConcurrentMapPut(m, i))));
+    }
+    threads->add(Thread::create(
+        Function::Ptr(new GTestConcurrentMapIterate(m))));
+
+    for (Size i = 0; i < threads->length(); i++) {
+        threads->getPtr<Thread>(i)->start();
+    }
+    for (Size i = 0; i < threads->length(); i++) {
+        threads->getPtr<Thread>(i)->join();
+    }
+
+    ASSERT_EQ(n * 500, m->size());
+    for (Int i = 0; i < n * 1000; i++) {
+        ASSERT_EQ(i % 2 == 0, m->containsKey(static_cast<Long>(i)));
+    }
+
+    Size count = 0;
+    Iterator::Ptr itr = m->keySet()->iterator();
+    while (itr->hasNext()) {
+        itr->next();
+        count++;
+    }
+    ASSERT_EQ(n * 500, count);
+}
+
+TEST(GTestConcurrentMap, TestConcurrentMerge) {
+    const Int n = 4;
+    ConcurrentMap::Ptr m = ConcurrentMap::create();
+    Function::Ptr sum(new GTestConcurrentMapSum());
+
+    JsArray::Ptr threads = JsArray::create();
+    for (Int i = 0; i < n; i++) {
+        threads->add(Thread::create(
+            Function::Ptr(new GTestConcurrentMapMerge(m, sum))));
+    }
+
+    for (Size i = 0; i < threads->length(); i++) {
+        threads->getPtr<Thread>(i)->start();
+    }
+    for (Size i = 0; i < threads->length(); i++) {
+        threads->getPtr<Thread>(i)->join();
+    }
+
+    ASSERT_EQ(10, m->size());
+    for (Long i = 0; i < 10; i++) {
+        ASSERT_TRUE(m->get(i).equals(n * 100));
+    }
+}
+
+TEST(GTestConcurrentMap, TestConcurrentPutAll) {
+    const Long n = 100000;
+    Map::Ptr src = Map::create();
+    for (Long i = 0; i < n; i++) {
+        src->put(i, i);
+    }
+
+    for (Int t = 0; t < 5; t++) {
+        ConcurrentMap::Ptr m = ConcurrentMap::create();
+        Thread::Ptr thread = Thread::create(
+            Function::Ptr(new GTestConcurrentMapPutAll(m, src)));
+        thread->start();
+
+        // once the first key of src is seen, the last one must be there
+        while (!m->containsKey(static_cast<Long>(0))) {}
+        ASSERT_TRUE(m->containsKey(n - 1));
+
+        thread->join();
+        ASSERT_EQ(n, m->size());
+    }
 }
 
 }  // namespace libj
@@ -281,5 +281,112 @@ TEST(GTestCvtUtf, TestUtf32ToUtf16) {
     ASSERT_EQ(static_cast<char16_t>(0xdc0b), s16[2]);
 }
 
+// covers both the vector loops and their scalar remainders
+TEST(GTestCvtUtf, TestLongAscii) {
+    for (size_t len = 1; len <= 70; len++) {
+        for (size_t i = 0; i < len; i++) {
+            std::string s8(len, 'a');
+            s8.replace(i, 1, "\xe3\x81\x82");
+            std::u32string s32(len, 'a');
+            s32[i] = 0x3042;
+
+            size_t n = 0;
+            std::u16string s16 = utf8ToUtf16(s8, &n);
+            ASSERT_EQ(len, n);
+            ASSERT_EQ(len, s16.length());
+            ASSERT_EQ(0x3042, s16[i]);
+            ASSERT_EQ(s32, toUtf32(s8.c_str(), UTF8, s8.length(), -1));
+            ASSERT_EQ(s8, utf16ToUtf8(s16));
+            ASSERT_EQ(s8, fromUtf32(s32, UTF8));
+
+            s32 = toUtf32(s8.c_str(), UTF8, -1, i);
+            ASSERT_EQ(std::u32string(i, 'a'), s32);
+        }
+    }
+}
+
+TEST(GTestCvtUtf, TestIllegalUtf8) {
+    const char* illegals[] = {
+        "\x80",
+        "\xc0\xaf",
+        "\xe0\x80\xaf",
+        "\xed\xa0\x80",
+        "\xf4\x90\x80\x80",
+        "\xf8\x88\x80\x80\x80",
+    };
+    for (size_t i = 0; i < sizeof(illegals) / sizeof(illegals[0]); i++) {
+        std::string s8 = std::string(40, 'a') + illegals[i] + "b";
+        std::u16string s16 = toUtf16(s8.c_str(), UTF8, -1, -1);
+        ASSERT_EQ(std::u16string(40, 'a'), s16);
+    }
+
+    std::u16string s16(40, 'a');
+    s16 += 0xdc00;
+    s16 += 'b';
+    ASSERT_EQ(std::string(40, 'a'), utf16ToUtf8(s16));
+}
+
+TEST(GTestCvtUtf, TestUtf8Decoder) {
+    std::string s8 = std::string(20, 'a') +
+        "\xe3\x81\x82" "b" "\xf0\xa0\x80\x8b" "c" "\xc2\xa9" + std::string(20, 'd');
+    std::u16string e16 = utf8ToUtf16(s8);
+    std::u32string e32 = toUtf32(s8.c_str(), UTF8, s8.length(), -1);
+    for (size_t i = 0; i <= s8.length(); i++) {
+        for (size_t j = i; j <= s8.length(); j++) {
+            Utf8Decoder decoder;
+            std::u16string s16;
+            decoder.decode(s8.c_str(), i, &s16);
+            decoder.decode(s8.c_str() + i, j - i, &s16);
+            decoder.decode(s8.c_str() + j, s8.length() - j, &s16);
+            ASSERT_FALSE(decoder.pending());
+            decoder.flush(&s16);
+            ASSERT_EQ(e16, s16);
+        }
+
+        Utf8Decoder decoder;
+        std::u32string s32;
+        decoder.decode(s8.c_str(), i, &s32);
+        decoder.decode(s8.c_str() + i, s8.length() - i, &s32);
+        ASSERT_EQ(e32, s32);
+    }
+}
+
+TEST(GTestCvtUtf, TestUtf8DecoderIllegal) {
+    const char* illegals[] = {
+        "\x80",
+        "\xc0\xaf",
+        "\xe0\x80\xaf",
+        "\xed\xa0\x80",
+        "\xf4\x90\x80\x80",
+        "\xe3\x81",
+        "\xf0\xa0\x80",
+    };
+    const size_t replaced[] = { 1, 2, 3, 3, 4, 1, 1 };
+    for (size_t i = 0; i < sizeof(illegals) / sizeof(illegals[0]); i++) {
+        std::string s8 = std::string("a") + illegals[i] + "b";
+        for (size_t j = 0; j <= s8.length(); j++) {
+            Utf8Decoder decoder;
+            std::u32string s32;
+            decoder.decode(s8.c_str(), j, &s32);
+            decoder.decode(s8.c_str() + j, s8.length() - j, &s32);
+            std::u32string e32(1, 'a');
+            e32.append(replaced[i], 0xfffd);
+            e32 += 'b';
+            ASSERT_EQ(e32, s32);
+        }
+    }
+
+    Utf8Decoder decoder;
+    std::u16string s16;
+    decoder.decode("a\0\xe3\x81", 4, &s16);
+    ASSERT_TRUE(decoder.pending());
+    decoder.flush(&s16);
+    ASSERT_FALSE(decoder.pending());
+    ASSERT_EQ(3, s16.length());
+    ASSERT_EQ('a', s16[0]);
+    ASSERT_EQ(0, s16[1]);
+    ASSERT_EQ(0xfffd, s16[2]);
+}
+
 }  // namespace glue
 }  // namespace libj
@@ -0,0 +1,190 @@
+// Copyright (c) 2013 Plenluno All rights reserved.
+
+#include <gtest/gtest.h>
+#include <libj/constant.h>
+#include <libj/hash_map.h>
+#include <libj/string.h>
+
+namespace libj {
+
+TEST(GTestHashMap, TestCreate) {
+    HashMap::Ptr m = HashMap::create();
+    ASSERT_TRUE(!!m);
+}
+
+TEST(GTestHashMap, TestInstanceOf) {
+    HashMap::Ptr m = HashMap::create();
+    ASSERT_TRUE(m->instanceof(Type<HashMap>::id()));
+    ASSERT_TRUE(m->instanceof(Type<Map>::id()));
+    ASSERT_TRUE(m->instanceof(Type<Mutable>::id()));
+    ASSERT_TRUE(m->instanceof(Type<Object>::id()));
+}
+
+TEST(GTestHashMap, TestSize) {
+    Map::Ptr m = HashMap::create();
+    m->put(String::create("x"), 123);
+    ASSERT_EQ(1, m->size());
+    m->put(String::create("y"), 456);
+    ASSERT_EQ(2, m->size());
+    m->put(123, String::create("x"));
+    ASSERT_EQ(3, m->size());
+    m->put(static_cast<Long>(123), String::create("x"));
+    ASSERT_EQ(4, m->size());
+    m->put(Object::null(), String::null());
+    ASSERT_EQ(5, m->size());
+    m->put(UNDEFINED, UNDEFINED);
+    ASSERT_EQ(6, m->size());
+}
+
+TEST(GTestHashMap, TestPutAndGet) {
+    Map::Ptr m = HashMap::create();
+    String::CPtr x = String::create("x");
+    ASSERT_TRUE(m->put(x, 123).isUndefined());
+    ASSERT_TRUE(m->get(x).equals(123));
+    ASSERT_TRUE(m->get(String::create("x")).equals(123));
+
+    ASSERT_TRUE(m->put(x, 456).equals(123));
+    ASSERT_TRUE(m->get(x).equals(456));
+    ASSERT_TRUE(m->get(String::intern("x")).equals(456));
+
+    ASSERT_TRUE(m->put(String::null(), 123).isUndefined());
+    ASSERT_TRUE(m->get(Map::null()).equals(123));
+    ASSERT_TRUE(m->put(UNDEFINED, 789).isUndefined());
+    ASSERT_TRUE(m->get(UNDEFINED).equals(789));
+
+    ASSERT_TRUE(m->put(0.0, 1).isUndefined());
+    ASSERT_TRUE(m->get(-0.0).equals(1));
+
+    ASSERT_TRUE(m->put(QUIET_NAN, 2).isUndefined());
+    ASSERT_TRUE(m->get(QUIET_NAN).equals(2));
+    ASSERT_TRUE(m->put(1.0, 3).isUndefined());
+    ASSERT_TRUE(m->get(QUIET_NAN).equals(2));
+    ASSERT_TRUE(m->get(1.0).equals(3));
+}
+
+TEST(GTestHashMap, TestPutAndGetMany) {
+    Map::Ptr m = HashMap::create();
+    for (Long i = 0; i < 10000; i++) {
+        m->put(i, String::valueOf(i));
+    }
+    ASSERT_EQ(10000, m->size());
+    for (Long i = 0; i < 10000; i++) {
+        ASSERT_TRUE(m->get(i).equals(String::valueOf(i)));
+    }
+    ASSERT_TRUE(m->get(static_cast<Long>(10000)).isUndefined());
+
+    for (Long i = 0; i < 10000; i += 2) {
+        ASSERT_TRUE(m->remove(i).equals(String::valueOf(i)));
+    }
+    ASSERT_EQ(5000, m->size());
+    for (Long i = 0; i < 10000; i++) {
+        ASSERT_EQ(i % 2 == 1, m->containsKey(i));
+    }
+}
+
+TEST(GTestHashMap, TestKeySet) {
+    Map::Ptr m = HashMap::create();
+    Iterator::Ptr itr = m->keySet()->iterator();
+    ASSERT_FALSE(itr->hasNext());
+
+    String::CPtr x = String::create("x");
+    String::CPtr y = String::create("y");
+    m->put(x, 123);
+    m->put(y, 456);
+
+    Set::CPtr ks = m->keySet();
+    ASSERT_EQ(2, ks->size());
+    ASSERT_TRUE(ks->contains(String::create("x")));
+    itr = ks->iterator();
+    ASSERT_TRUE(itr->hasNext());
+    String::CPtr v1 = toCPtr<String>(itr->next());
+    ASSERT_TRUE(v1->equals(x) || v1->equals(y));
+    ASSERT_TRUE(itr->hasNext());
+    String::CPtr v2 = toCPtr<String>(itr->next());
+    ASSERT_TRUE(!v1->equals(v2) && (v2->equals(x) || v2->equals(y)));
+    ASSERT_FALSE(itr->hasNext());
+}
+
+TEST(GTestHashMap, TestEntrySet) {
+    Map::Ptr m = HashMap::create();
+    TypedSet<Map::Entry::CPtr>::CPtr es = m->entrySet();
+    ASSERT_FALSE(es->iteratorTyped()->hasNext());
+
+    m->put(String::create("x"), 123);
+    m->put(String::create("y"), 456);
+
+    es = m->entrySet();
+    TypedIterator<Map::Entry::CPtr>::Ptr ti = es->iteratorTyped();
+    Int sum = 0;
+    while (ti->hasNext()) {
+        Map::Entry::CPtr e = ti->nextTyped();
+        sum += to<Int>(e->getValue());
+        ASSERT_TRUE(m->get(e->getKey()).equals(e->getValue()));
+    }
+    ASSERT_EQ(579, sum);
+}
+
+TEST(GTestHashMap, TestContainsValue) {
+    Map::Ptr m = HashMap::create();
+    m->put(String::create("x"), 123);
+    ASSERT_TRUE(m->containsValue(123));
+    ASSERT_FALSE(m->containsValue(456));
+
+    m->put(String::create("y"), String::null());
+    ASSERT_TRUE(m->containsValue(String::null()));
+}
+
+TEST(GTestHashMap, TestClear) {
+    Map::Ptr m = HashMap::create();
+    m->put(String::create("x"), 123);
+    m->put(String::null(), UNDEFINED);
+    m->clear();
+    ASSERT_TRUE(m->isEmpty());
+    ASSERT_FALSE(m->containsKey(String::create("x")));
+
+    m->put(String::create("x"), 456);
+    ASSERT_TRUE(m->get(String::create("x")).equals(456));
+}
+
+TEST(GTestHashMap, TestRemove) {
+    Map::Ptr m = HashMap::create();
+    String::CPtr x = String::create("x");
+    String::CPtr z = String::create("z");
+    m->put(x, 123);
+    m->put(String::null(), z);
+    m->put(UNDEFINED, UNDEFINED);
+    ASSERT_EQ(3, m->size());
+    ASSERT_TRUE(m->remove(x).equals(123));
+    ASSERT_TRUE(m->remove(x).isUndefined());
+    ASSERT_EQ(2, m->size());
+    ASSERT_TRUE(m->remove(String::null()).equals(z));
+    ASSERT_TRUE(m->remove(UNDEFINED).isUndefined());
+    ASSERT_TRUE(m->isEmpty());
+}
+
+TEST(GTestHashMap, TestToString) {
+    Map::Ptr m = HashMap::create();
+    ASSERT_TRUE(m->toString()->equals(String::create("{}")));
+
+    m->put(String::create("x"), 123);
+    ASSERT_TRUE(m->toString()->equals(String::create("{x=123}")));
+}
+
+TEST(GTestHashMap, TestPutAll) {
+    Map::Ptr m1 = HashMap::create();
+    m1->put(1, 1);
+    m1->put(2, 2);
+
+    Map::Ptr m2 = Map::create();
+    for (Int i = 2; i < 100; i++) {
+        m2->put(i, -i);
+    }
+
+    m1->putAll(m2);
+    ASSERT_EQ(99, m1->size());
+    ASSERT_TRUE(m1->get(1).equals(1));
+    for (Int i = 2; i < 100; i++) {
+        ASSERT_TRUE(m1->get(i).equals(-i));
+    }
+}
+}  // namespace libj
@@ -0,0 +1,85 @@
+// Copyright (c) 2013 Plenluno All rights reserved.
+
+#include <gtest/gtest.h>
+#include <libj/hash_set.h>
+#include <libj/string.h>
+
+namespace libj {
+
+TEST(GTestHashSet, TestCreate) {
+    HashSet::Ptr s = HashSet::create();
+    ASSERT_TRUE(!!s);
+}
+
+TEST(GTestHashSet, TestInstanceOf) {
+    HashSet::Ptr s = HashSet::create();
+    ASSERT_TRUE(s->instanceof(Type<HashSet>::id()));
+    ASSERT_TRUE(s->instanceof(Type<Set>::id()));
+    ASSERT_TRUE(s->instanceof(Type<Collection>::id()));
+    ASSERT_TRUE(s->instanceof(Type<Object>::id()));
+}
+
+TEST(GTestHashSet, TestAdd) {
+    Set::Ptr s = HashSet::create();
+    ASSERT_TRUE(s->add(5));
+    ASSERT_FALSE(s->add(5));
+    ASSERT_TRUE(s->add(String::create("abc")));
+    ASSERT_FALSE(s->add(String::create("abc")));
+    ASSERT_TRUE(s->add(String::null()));
+    ASSERT_FALSE(s->add(Set::null()));
+    ASSERT_TRUE(s->add(UNDEFINED));
+    ASSERT_EQ(4, s->size());
+}
+
+TEST(GTestHashSet, TestIterator) {
+    Set::Ptr s = HashSet::create();
+    s->add(123);
+    s->add(456);
+
+    int v1, v2;
+    Iterator::Ptr itr = s->iterator();
+    ASSERT_TRUE(itr->hasNext());
+    ASSERT_TRUE(to<int>(itr->next(), &v1));
+    ASSERT_TRUE(v1 == 123 || v1 == 456);
+    ASSERT_TRUE(itr->hasNext());
+    ASSERT_TRUE(to<int>(itr->next(), &v2));
+    ASSERT_TRUE(v2 != v1 && (v2 == 123 || v2 == 456));
+    ASSERT_FALSE(itr->hasNext());
+}
+
+TEST(GTestHashSet, TestContainsAndRemove) {
+    Set::Ptr s = HashSet::create();
+    for (Int i = 0; i < 1000; i++) {
+        s->add(String::valueOf(i));
+    }
+    ASSERT_TRUE(s->contains(String::create("999")));
+    ASSERT_FALSE(s->contains(999));
+
+    for (Int i = 0; i < 1000; i += 3) {
+        ASSERT_TRUE(s->remove(String::valueOf(i)));
+    }
+    ASSERT_FALSE(s->remove(String::create("0")));
+    ASSERT_EQ(666, s->size());
+    for (Int i = 0; i < 1000; i++) {
+        ASSERT_EQ(i % 3 != 0, s->contains(String::valueOf(i)));
+    }
+}
+
+TEST(GTestHashSet, TestRetainAll) {
+    Set::Ptr s1 = HashSet::create();
+    s1->add(3);
+    s1->add(5);
+
+    Set::Ptr s2 = Set::create();
+    s2->add(5);
+    s2->add(7);
+
+    ASSERT_TRUE(s1->retainAll(s2));
+    ASSERT_EQ(1, s1->size());
+    ASSERT_TRUE(s1->contains(5));
+
+    s1->clear();
+    ASSERT_TRUE(s1->isEmpty());
+}
+
+}  // namespace libj
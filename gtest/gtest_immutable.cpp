@@ -34,7 +34,7 @@ class GTestImmutableX {
     virtual int x() { return 0; }
 };
 
-#ifndef LIBJ_PF_WINDOWS
+#if !defined(LIBJ_PF_WINDOWS) && !defined(LIBJ_USE_INTRUSIVE_PTR)
 
 TEST(GTestImmutable, TestEBCO) {
     ASSERT_EQ(
@@ -79,26 +79,34 @@ TEST(GTestImmutable, TestIs) {
 
 #ifdef LIBJ_USE_SP
 
+#ifdef LIBJ_USE_INTRUSIVE_PTR
+template<typename P>
+static Long useCount(const P& p) { return p->useCount(); }
+#else
+template<typename P>
+static Long useCount(const P& p) { return p.use_count(); }
+#endif
+
 TEST(GTestImmutable, TestUseCount) {
     {
         GTestImmutable::CPtr p = GTestImmutable::create();
-        ASSERT_EQ(1, p.use_count());
+        ASSERT_EQ(1, useCount(p));
         ASSERT_EQ(1, GTestImmutable::count);
 
         GTestImmutable::CPtr p2 = GTestImmutable::create();
-        ASSERT_EQ(1, p2.use_count());
+        ASSERT_EQ(1, useCount(p2));
         ASSERT_EQ(2, GTestImmutable::count);
 
         p = p2;
-        ASSERT_EQ(2, p.use_count());
-        ASSERT_EQ(2, p2.use_count());
+        ASSERT_EQ(2, useCount(p));
+        ASSERT_EQ(2, useCount(p2));
         ASSERT_EQ(1, GTestImmutable::count);
 
         GTestImmutable::CPtr p3 =
             LIBJ_STATIC_CPTR_CAST(GTestImmutable)((&(*p))->self());
-        ASSERT_EQ(3, p.use_count());
-        ASSERT_EQ(3, p2.use_count());
-        ASSERT_EQ(3, p3.use_count());
+        ASSERT_EQ(3, useCount(p));
+        ASSERT_EQ(3, useCount(p2));
+        ASSERT_EQ(3, useCount(p3));
         ASSERT_EQ(1, GTestImmutable::count);
     }
     ASSERT_EQ(0, GTestImmutable::count);
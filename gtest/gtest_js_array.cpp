@@ -89,6 +89,20 @@ TEST(GTestJsArray, TestSubList) {
 #endif  // LIBJ_USE_EXCEPTION
 }
 
+#ifdef LIBJ_USE_CXX11
+TEST(GTestJsArray, TestMove) {
+    JsArray::Ptr a = JsArray::create();
+    Value abc = String::create("abc");
+    Value def = String::create("def");
+    ASSERT_TRUE(a->add(std::move(abc)));
+    ASSERT_TRUE(a->add(0, std::move(def)));
+    ASSERT_EQ(3, a->push(String::create("ghi")));
+    ASSERT_TRUE(abc.isUndefined());
+    ASSERT_TRUE(def.isUndefined());
+    ASSERT_TRUE(a->toString()->equals(String::create("def,abc,ghi")));
+}
+#endif
+
 TEST(GTestJsArray, TestJsProperty) {
     JsArray::Ptr a = JsArray::create();
     a->setProperty(String::create("abc"), 7);
@@ -99,4 +113,20 @@ TEST(GTestJsArray, TestJsProperty) {
     ASSERT_FALSE(a->hasProperty(String::create("abc")));
 }
 
+TEST(GTestJsArray, TestJoin) {
+    JsArray::Ptr a = JsArray::create();
+    ASSERT_TRUE(a->join()->isEmpty());
+
+    a->add(1);
+    a->add(UNDEFINED);
+    a->add(String::create("abc"));
+    a->add(Value());
+    a->add(false);
+    ASSERT_TRUE(a->join()->equals(String::create("1,,abc,,false")));
+    ASSERT_TRUE(a->join(String::create(" - "))->equals(
+        String::create("1 -  - abc -  - false")));
+    ASSERT_TRUE(a->join(String::create())->equals(
+        String::create("1abcfalse")));
+}
+
 }  // namespace libj
@@ -3,6 +3,7 @@
 #include <gtest/gtest.h>
 #include <libj/js_object.h>
 #include <libj/bridge/abstract_js_object.h>
+#include <libj/detail/shape.h>
 
 namespace libj {
 
@@ -64,4 +65,257 @@ TEST(GTestJsObject, TestGetCPtr) {
     ASSERT_TRUE(obj->getCPtr<JsObject>(abc)->equals(obj2));
 }
 
+TEST(GTestJsObject, TestInsertionOrder) {
+    JsObject::Ptr obj = JsObject::create();
+    obj->put(String::create("z"), 1);
+    obj->put(String::create("a"), 2);
+    obj->put(3, 3);
+    obj->put(String::create("a"), 4);
+
+    TypedIterator<Map::Entry::CPtr>::Ptr itr =
+        obj->entrySet()->iteratorTyped();
+    Map::Entry::CPtr e = itr->nextTyped();
+    ASSERT_TRUE(e->getKey().equals(String::create("z")));
+    ASSERT_TRUE(e->getValue().equals(1));
+    e = itr->nextTyped();
+    ASSERT_TRUE(e->getKey().equals(String::create("a")));
+    ASSERT_TRUE(e->getValue().equals(4));
+    e = itr->nextTyped();
+    ASSERT_TRUE(e->getKey().equals(String::create("3")));
+    ASSERT_FALSE(itr->hasNext());
+}
+
+TEST(GTestJsObject, TestRemove) {
+    JsObject::Ptr obj1 = JsObject::create();
+    JsObject::Ptr obj2 = JsObject::create();
+    String::CPtr keys[] = {
+        String::create("x"),
+        String::create("y"),
+        String::create("z"),
+    };
+    for (Size i = 0; i < 3; i++) {
+        obj1->put(keys[i], static_cast<Int>(i));
+        obj2->put(keys[i], static_cast<Int>(i));
+    }
+
+    ASSERT_TRUE(obj1->remove(keys[2]).equals(2));
+    ASSERT_TRUE(obj1->remove(keys[0]).equals(0));
+    ASSERT_TRUE(obj1->remove(keys[0]).isUndefined());
+    ASSERT_EQ(1, obj1->size());
+    ASSERT_TRUE(obj1->get(keys[1]).equals(1));
+    obj1->put(keys[0], 5);
+    Iterator::Ptr itr = obj1->keySet()->iterator();
+    ASSERT_TRUE(itr->next().equals(keys[1]));
+    ASSERT_TRUE(itr->next().equals(keys[0]));
+    ASSERT_FALSE(itr->hasNext());
+
+    // obj2 shares the keys obj1 had before the removal
+    ASSERT_EQ(3, obj2->size());
+    ASSERT_TRUE(obj2->get(keys[0]).equals(0));
+    ASSERT_TRUE(obj2->get(keys[2]).equals(2));
+
+    obj2->clear();
+    ASSERT_TRUE(obj2->isEmpty());
+    ASSERT_FALSE(obj2->containsKey(keys[0]));
+    obj2->put(keys[2], 7);
+    ASSERT_TRUE(obj2->get(keys[2]).equals(7));
+}
+
+TEST(GTestJsObject, TestManyProperties) {
+    JsObject::Ptr obj = JsObject::create();
+    for (Int i = 0; i < 1000; i++) {
+        obj->put(i, i);
+    }
+    ASSERT_EQ(1000, obj->size());
+    for (Int i = 0; i < 1000; i += 2) {
+        ASSERT_TRUE(obj->remove(i).equals(i));
+    }
+    ASSERT_EQ(500, obj->size());
+
+    Int i = 1;
+    Iterator::Ptr itr = obj->keySet()->iterator();
+    while (itr->hasNext()) {
+        ASSERT_TRUE(itr->next().equals(String::valueOf(i)));
+        ASSERT_TRUE(obj->get(i).equals(i));
+        i += 2;
+    }
+    ASSERT_EQ(1001, i);
+}
+
+// compacts the holes left by the removals in dictionary mode
+TEST(GTestJsObject, TestManyProperties2) {
+    JsObject::Ptr obj = JsObject::create();
+    for (Int i = 0; i < 1000; i++) {
+        obj->put(i, i);
+    }
+    for (Int i = 0; i < 1000; i++) {
+        if (i % 4) ASSERT_TRUE(obj->remove(i).equals(i));
+    }
+    ASSERT_EQ(250, obj->size());
+    ASSERT_FALSE(obj->containsValue(UNDEFINED));
+    obj->put(1, 1);
+
+    Int i = 0;
+    TypedIterator<Map::Entry::CPtr>::Ptr itr =
+        obj->entrySet()->iteratorTyped();
+    while (i < 1000) {
+        Map::Entry::CPtr e = itr->nextTyped();
+        ASSERT_TRUE(e->getKey().equals(String::valueOf(i)));
+        ASSERT_TRUE(e->getValue().equals(i));
+        i += 4;
+    }
+    ASSERT_TRUE(itr->nextTyped()->getKey().equals(String::valueOf(1)));
+    ASSERT_FALSE(itr->hasNext());
+    ASSERT_EQ(251, obj->size());
+    ASSERT_TRUE(obj->get(996).equals(996));
+    ASSERT_TRUE(obj->get(997).isUndefined());
+}
+
+TEST(GTestJsObject, TestPropertyKey) {
+    LIBJ_STATIC_JS_PROPERTY_KEY_DEF(keyX, "x");
+    LIBJ_STATIC_JS_PROPERTY_KEY_DEF(keyY, "y");
+    ASSERT_TRUE(keyX.name()->equals(String::create("x")));
+
+    JsObject::Ptr obj1 = JsObject::create();
+    obj1->put(String::create("x"), 1);
+    obj1->put(String::create("y"), 2);
+    ASSERT_TRUE(obj1->hasProperty(keyX));
+    ASSERT_TRUE(obj1->getProperty(keyX).equals(1));
+    ASSERT_TRUE(obj1->getProperty(keyY).equals(2));
+
+    // the same keys in another order
+    JsObject::Ptr obj2 = JsObject::create();
+    obj2->put(String::create("y"), 3);
+    obj2->put(String::create("x"), 4);
+    ASSERT_TRUE(obj2->getProperty(keyX).equals(4));
+    ASSERT_TRUE(obj1->getProperty(keyX).equals(1));
+    ASSERT_TRUE(obj2->setProperty(keyX, 5).equals(4));
+    ASSERT_TRUE(obj2->get(String::create("x")).equals(5));
+
+    // dictionary mode
+    obj2->remove(String::create("y"));
+    ASSERT_FALSE(obj2->hasProperty(keyY));
+    ASSERT_TRUE(obj2->getProperty(keyY).isUndefined());
+    ASSERT_TRUE(obj2->getProperty(keyX).equals(5));
+
+    // added by setProperty
+    ASSERT_TRUE(obj2->setProperty(keyY, 6).isUndefined());
+    ASSERT_TRUE(obj2->getProperty(keyY).equals(6));
+
+    JsObject::Ptr obj3 = GTestJsObject::create();
+    ASSERT_TRUE(obj3->setProperty(keyX, 7).isUndefined());
+    ASSERT_TRUE(obj3->getProperty(keyX).equals(7));
+    ASSERT_FALSE(obj3->hasProperty(keyY));
+}
+
+TEST(GTestJsObject, TestPutAll) {
+    JsObject::Ptr obj = JsObject::create();
+    obj->put(String::create("y"), 1);
+
+    Map::Ptr m = Map::create();
+    m->put(String::create("x"), 2);
+    m->put(String::create("y"), 3);
+
+    obj->putAll(m);
+    ASSERT_EQ(2, obj->size());
+    ASSERT_TRUE(obj->get(String::create("x")).equals(2));
+    ASSERT_TRUE(obj->get(String::create("y")).equals(3));
+}
+
+class GTestJsObjectCounter : public bridge::AbstractJsObject<GTestJsObject> {
+ public:
+    GTestJsObjectCounter() : count(0) {}
+
+    virtual Value put(const Value& key, const Value& val) {
+        count++;
+        return bridge::AbstractJsObject<GTestJsObject>::put(key, val);
+    }
+
+#ifdef LIBJ_USE_CXX11
+    using bridge::AbstractJsObject<GTestJsObject>::put;
+#endif
+
+    Size count;
+};
+
+TEST(GTestJsObject, TestBridgePut) {
+    LIBJ_PTR(GTestJsObjectCounter) obj(new GTestJsObjectCounter());
+    obj->put(String::create("x"), 1);
+    Value key = String::create("y");
+    obj->put(key, 2);
+    ASSERT_EQ(2, obj->count);
+    ASSERT_TRUE(obj->get(String::create("x")).equals(1));
+    ASSERT_TRUE(obj->get(String::create("y")).equals(2));
+}
+
+// lowers the limit of the shared shapes while it is in scope
+class GTestSharedShapesLimit {
+ public:
+    GTestSharedShapesLimit(Size n)
+        : limit_(detail::Shape::setSharedShapesLimit(
+            detail::Shape::numSharedShapes() + n)) {}
+
+    ~GTestSharedShapesLimit() {
+        detail::Shape::setSharedShapesLimit(limit_);
+    }
+
+ private:
+    Size limit_;
+};
+
+// more orders of keys than the shared shapes can hold
+TEST(GTestJsObject, TestManyShapes) {
+    const Size limit = 64;
+    Size base = detail::Shape::numSharedShapes();
+    GTestSharedShapesLimit scope(limit);
+
+    const Int n = 8;
+    String::CPtr keys[n * 3];
+    for (Int i = 0; i < n * 3; i++) {
+        keys[i] = String::valueOf(i);
+    }
+
+    for (Int i = 0; i < n; i++) {
+        for (Int j = 0; j < n; j++) {
+            for (Int k = 0; k < n; k++) {
+                JsObject::Ptr obj = JsObject::create();
+                obj->put(keys[i], i);
+                obj->put(keys[n + j], j);
+                obj->put(keys[n * 2 + k], k);
+                ASSERT_EQ(3, obj->size());
+                ASSERT_TRUE(obj->get(keys[i]).equals(i));
+                ASSERT_TRUE(obj->get(keys[n + j]).equals(j));
+                ASSERT_TRUE(obj->get(keys[n * 2 + k]).equals(k));
+            }
+        }
+    }
+    ASSERT_GE(base + limit, detail::Shape::numSharedShapes());
+
+    // in dictionary mode, from which the key caches nothing
+    LIBJ_STATIC_JS_PROPERTY_KEY_DEF(keyNew, "new");
+    JsObject::Ptr obj = JsObject::create();
+    obj->put(String::create("new"), 1);
+    ASSERT_TRUE(obj->getProperty(keyNew).equals(1));
+    ASSERT_TRUE(obj->setProperty(keyNew, 2).equals(1));
+    ASSERT_TRUE(obj->getProperty(keyNew).equals(2));
+}
+
+TEST(GTestJsObject, TestNoSharedShapes) {
+    GTestSharedShapesLimit scope(0);
+    ASSERT_TRUE(detail::Shape::root()->isShared());
+
+    JsObject::Ptr a = JsObject::create();
+    JsObject::Ptr b = JsObject::create();
+    a->put(String::create("a"), 1);
+    b->put(String::create("b"), 2);
+    ASSERT_EQ(1, a->size());
+    ASSERT_EQ(1, b->size());
+    ASSERT_FALSE(a->containsKey(String::create("b")));
+    ASSERT_FALSE(b->containsKey(String::create("a")));
+
+    a = JsObject::null();
+    ASSERT_EQ(0, JsObject::create()->size());
+    ASSERT_TRUE(b->get(String::create("b")).equals(2));
+}
+
 }  // namespace libj
@@ -102,4 +102,53 @@ TEST(GTestJsRegExp, TestLastIndex) {
     ASSERT_EQ(0, re->lastIndex());
 }
 
+TEST(GTestJsRegExp, TestExec3) {
+    JsRegExp::Ptr re =
+        JsRegExp::create(String::create("b(c)"), JsRegExp::GLOBAL);
+    String::CPtr s = String::create("abcabc");
+
+    JsArray::Ptr a = re->exec(s);
+    ASSERT_EQ(2, a->length());
+    ASSERT_TRUE(a->getCPtr<String>(0)->equals(String::create("bc")));
+    ASSERT_TRUE(a->getCPtr<String>(1)->equals(String::create("c")));
+    Int index = -1;
+    to<Int>(a->getProperty(String::create("index")), &index);
+    ASSERT_EQ(1, index);
+    ASSERT_EQ(3, re->lastIndex());
+
+    a = re->exec(s);
+    ASSERT_TRUE(a->getCPtr<String>(0)->equals(String::create("bc")));
+    to<Int>(a->getProperty(String::create("index")), &index);
+    ASSERT_EQ(4, index);
+    String::CPtr input =
+        toCPtr<String>(a->getProperty(String::create("input")));
+    ASSERT_TRUE(input->equals(s));
+    ASSERT_EQ(6, re->lastIndex());
+
+    ASSERT_FALSE(re->exec(s));
+    ASSERT_EQ(0, re->lastIndex());
+}
+
+TEST(GTestJsRegExp, TestSplit) {
+    JsRegExp::Ptr re = JsRegExp::create(String::create("(-)|\\+"));
+    JsArray::Ptr a = re->split(String::create("1-2+3"));
+    ASSERT_EQ(5, a->length());
+    ASSERT_TRUE(a->getCPtr<String>(1)->equals(String::create("-")));
+    ASSERT_TRUE(a->get(3).isUndefined());
+    ASSERT_TRUE(a->getCPtr<String>(4)->equals(String::create("3")));
+
+    a = re->split(String::create("1-2+3"), 2);
+    ASSERT_EQ(2, a->length());
+
+    re = JsRegExp::create(String::create(""), JsRegExp::GLOBAL);
+    a = re->split(String::create("abc"));
+    ASSERT_TRUE(a->toString()->equals(String::create("a,b,c")));
+    ASSERT_EQ(0, re->lastIndex());
+    ASSERT_EQ(0, re->split(String::create(""))->length());
+
+    re = JsRegExp::create(String::create("x"));
+    ASSERT_EQ(1, re->split(String::create(""))->length());
+    ASSERT_FALSE(re->split(String::null()));
+}
+
 }  // namespace libj
@@ -1,6 +1,7 @@
 // Copyright (c) 2012-2013 Plenluno All rights reserved.
 
 #include <gtest/gtest.h>
+#include <libj/hash_map.h>
 #include <libj/map.h>
 #include <libj/string.h>
 
@@ -227,4 +228,52 @@ TEST(GTestMap, TestToString) {
         String::create("{undefined=undefined, null=z, x=123, y=null}")));
 }
 
+TEST(GTestMap, TestPutAll) {
+    Map::Ptr m1 = Map::create();
+    for (Int i = 0; i < 100; i += 2) {
+        m1->put(i, i);
+    }
+
+    Map::Ptr m2 = Map::create();
+    for (Int i = 0; i < 100; i += 3) {
+        m2->put(i, -i);
+    }
+    m2->put(String::create("x"), 1);
+
+    m1->putAll(m2);
+    ASSERT_EQ(50 + 34 - 17 + 1, m1->size());
+    for (Int i = 0; i < 100; i++) {
+        if (i % 3 == 0) {
+            ASSERT_TRUE(m1->get(i).equals(-i));
+        } else if (i % 2 == 0) {
+            ASSERT_TRUE(m1->get(i).equals(i));
+        } else {
+            ASSERT_FALSE(m1->containsKey(i));
+        }
+    }
+    ASSERT_TRUE(m1->get(String::create("x")).equals(1));
+
+    m1->putAll(m1);
+    ASSERT_EQ(68, m1->size());
+    m1->putAll(Map::null());
+    ASSERT_EQ(68, m1->size());
+}
+
+TEST(GTestMap, TestPutAllUnsorted) {
+    Map::Ptr m1 = Map::create();
+    m1->put(1, 1);
+    m1->put(3, 3);
+    m1->put(5, 5);
+
+    Map::Ptr m2 = HashMap::create();
+    for (Int i = 0; i < 8; i++) {
+        m2->put(i, -i);
+    }
+
+    m1->putAll(m2);
+    ASSERT_EQ(8, m1->size());
+    for (Int i = 0; i < 8; i++) {
+        ASSERT_TRUE(m1->get(i).equals(-i));
+    }
+}
 }  // namespace libj
@@ -35,7 +35,7 @@ class GTestMutableX {
     virtual int x() { return 0; }
 };
 
-#ifndef LIBJ_PF_WINDOWS
+#if !defined(LIBJ_PF_WINDOWS) && !defined(LIBJ_USE_INTRUSIVE_PTR)
 
 TEST(GTestMutable, TestEBCO) {
     ASSERT_EQ(
@@ -92,28 +92,43 @@ TEST(GTestMutable, TestIs) {
     ASSERT_FALSE(p->is<Immutable>());
 }
 
+TEST(GTestMutable, TestHashCode) {
+    GTestMutable::Ptr p = GTestMutable::create();
+    Object::CPtr p2 = p;
+    ASSERT_EQ(p->hashCode(), p2->hashCode());
+    ASSERT_NE(p->hashCode(), GTestMutable::create()->hashCode());
+}
+
 #ifdef LIBJ_USE_SP
 
+#ifdef LIBJ_USE_INTRUSIVE_PTR
+template<typename P>
+static Long useCount(const P& p) { return p->useCount(); }
+#else
+template<typename P>
+static Long useCount(const P& p) { return p.use_count(); }
+#endif
+
 TEST(GTestMutable, TestUseCount) {
     {
         GTestMutable::Ptr p = GTestMutable::create();
-        ASSERT_EQ(1, p.use_count());
+        ASSERT_EQ(1, useCount(p));
         ASSERT_EQ(1, GTestMutable::count);
 
         GTestMutable::Ptr p2 = GTestMutable::create();
-        ASSERT_EQ(1, p2.use_count());
+        ASSERT_EQ(1, useCount(p2));
         ASSERT_EQ(2, GTestMutable::count);
 
         p = p2;
-        ASSERT_EQ(2, p.use_count());
-        ASSERT_EQ(2, p2.use_count());
+        ASSERT_EQ(2, useCount(p));
+        ASSERT_EQ(2, useCount(p2));
         ASSERT_EQ(1, GTestMutable::count);
 
         GTestMutable::Ptr p3 =
             LIBJ_STATIC_PTR_CAST(GTestMutable)((&(*p))->self());
-        ASSERT_EQ(3, p.use_count());
-        ASSERT_EQ(3, p2.use_count());
-        ASSERT_EQ(3, p3.use_count());
+        ASSERT_EQ(3, useCount(p));
+        ASSERT_EQ(3, useCount(p2));
+        ASSERT_EQ(3, useCount(p3));
         ASSERT_EQ(1, GTestMutable::count);
     }
     ASSERT_EQ(0, GTestMutable::count);
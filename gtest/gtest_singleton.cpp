@@ -19,7 +19,7 @@ class GTestSingletonX {
     virtual int x() { return 0; }
 };
 
-#ifndef LIBJ_PF_WINDOWS
+#if !defined(LIBJ_PF_WINDOWS) && !defined(LIBJ_USE_INTRUSIVE_PTR)
 
 TEST(GTestSingleton, TestEBCO) {
     ASSERT_EQ(sizeof(GTestSingletonX), sizeof(GTestSingleton));
@@ -76,6 +76,29 @@ class GTestSingleton2 : public SingletonTmpl<GTestSingleton2> {
 
 int GTestSingleton2::count = 0;
 
+#ifdef LIBJ_USE_INTRUSIVE_PTR
+
+TEST(GTestSingleton, TestUseCount) {
+    {
+        // the instance holds a reference to itself
+        GTestSingleton2::Ptr p = GTestSingleton2::instance();
+        ASSERT_EQ(2, p->useCount());
+        ASSERT_EQ(1, GTestSingleton2::count);
+
+        GTestSingleton2::Ptr p2 = GTestSingleton2::instance();
+        ASSERT_EQ(3, p->useCount());
+        ASSERT_EQ(1, GTestSingleton2::count);
+
+        p = p2;
+        ASSERT_EQ(3, p->useCount());
+        ASSERT_EQ(1, GTestSingleton2::count);
+    }
+    ASSERT_EQ(1, GTestSingleton2::count);
+    ASSERT_EQ(2, GTestSingleton2::instance()->useCount());
+}
+
+#else
+
 TEST(GTestSingleton, TestUseCount) {
     {
         GTestSingleton2::Ptr p = GTestSingleton2::instance();
@@ -93,6 +116,8 @@ TEST(GTestSingleton, TestUseCount) {
     }
     ASSERT_EQ(1, GTestSingleton2::count);
 }
+
+#endif  // LIBJ_USE_INTRUSIVE_PTR
 #endif
 
 }  // namespace libj
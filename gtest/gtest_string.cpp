@@ -1,7 +1,9 @@
 // Copyright (c) 2012-2013 Plenluno All rights reserved.
 
 #include <gtest/gtest.h>
+#include <libj/js_regexp.h>
 #include <libj/string.h>
+#include <libj/detail/string.h>
 
 #pragma GCC diagnostic ignored "-Wnarrowing"
 
@@ -288,6 +290,45 @@ TEST(GTestString, TestSubstring) {
     ASSERT_TRUE(s5->equals(ss5));
 }
 
+TEST(GTestString, TestSubstring2) {
+    std::string s8;
+    for (Size i = 0; i < 100; i++) {
+        s8 += static_cast<char>('a' + i % 26);
+    }
+    String::CPtr s = String::create(s8.c_str());
+    String::CPtr ss = s->substring(10, 90);
+    ASSERT_EQ(80, ss->length());
+    ASSERT_EQ(s8.substr(10, 80), ss->toStdString());
+
+    String::CPtr sss = ss->substring(5, 75);
+    ASSERT_EQ(s8.substr(15, 70), sss->toStdString());
+    ASSERT_TRUE(sss->equals(String::create(s8.substr(15, 70).c_str())));
+    ASSERT_EQ(0, sss->data()[70]);
+    ASSERT_EQ('p', sss->data()[0]);
+
+    s = String::null();
+    ss = String::null();
+    ASSERT_EQ(s8.substr(15, 70), sss->toStdString());
+    ASSERT_EQ(s8.substr(16, 69) + "x", sss->substring(1)->concat(
+        String::create("x"))->toStdString());
+
+    std::string w8;
+    for (Size i = 0; i < 50; i++) {
+        w8 += "\xe6\x97\xa5";
+    }
+    String::CPtr w = String::create((w8 + "abc").c_str());
+    String::CPtr ws = w->substring(10);
+    ASSERT_EQ(43, ws->length());
+    ASSERT_EQ(0x65e5, ws->charAt(0));
+    ASSERT_EQ('c', ws->charAt(42));
+    ASSERT_EQ(0, ws->data()[43]);
+    ASSERT_EQ(40, ws->indexOf(String::create("abc")));
+
+    std::string h8(100000, 'x');
+    String::CPtr h = String::create((h8 + "abc").c_str());
+    ASSERT_TRUE(h->substring(100000)->equals(String::create("abc")));
+}
+
 TEST(GTestString, TestReplace) {
     String::CPtr s = str();
     ASSERT_EQ(str(), s->replace('a', 'b'));
@@ -325,6 +366,43 @@ TEST(GTestString, TestConcat) {
     ASSERT_FALSE(s->concat(String::null()));
 }
 
+TEST(GTestString, TestConcat2) {
+    String::CPtr abc = String::create("abcdefghijklmnopqrstuvwxyz");
+    String::CPtr s = String::create();
+    const Size n = 100000;
+    for (Size i = 0; i < n; i++) {
+        s = s->concat(abc);
+    }
+    ASSERT_EQ(26 * n, s->length());
+    ASSERT_EQ('a', s->charAt(26 * (n - 1)));
+    ASSERT_EQ('z', s->charAt(26 * n - 1));
+    ASSERT_TRUE(s->endsWith(abc));
+
+    String::CPtr s1 = abc->concat(abc);
+    String::CPtr s2 = s1->concat(s1);
+    String::CPtr s3 = String::create("\xe6\x97\xa5")->concat(s2);
+    ASSERT_TRUE(s->startsWith(s2));
+    ASSERT_EQ(104, s2->length());
+    ASSERT_EQ(105, s3->length());
+    ASSERT_EQ(0x65e5, s3->charAt(0));
+    ASSERT_EQ('z', s3->charAt(104));
+    ASSERT_TRUE(s3->substring(1)->equals(s2));
+    ASSERT_EQ(0, s3->data()[105]);
+}
+
+TEST(GTestString, TestConcat3) {
+    String::CPtr abc = String::create("abcdefghijklmnopqrstuvwxyz");
+    String::CPtr s = String::create();
+    const Size n = 10000;
+    for (Size i = 0; i < n; i++) {
+        s = s->concat(abc);
+        ASSERT_EQ('z', s->charAt(26 * i + 25));
+    }
+    ASSERT_EQ(26 * n, s->length());
+    ASSERT_TRUE(s->startsWith(abc));
+    ASSERT_TRUE(s->endsWith(abc));
+}
+
 TEST(GTestString, TestCompareTo) {
     String::CPtr a = String::create("a");
     String::CPtr c = String::create("c");
@@ -367,6 +445,32 @@ TEST(GTestString, TestEquals) {
     ASSERT_FALSE(internedAbc->equals(abcd));
 }
 
+TEST(GTestString, TestHashCode) {
+    String::CPtr abc = String::create("abc");
+    ASSERT_EQ(abc->hashCode(), String::create("abc")->hashCode());
+    ASSERT_EQ(abc->hashCode(), String::intern(abc)->hashCode());
+    ASSERT_NE(abc->hashCode(), String::create("abd")->hashCode());
+
+    // "\u00e9" is stored in one byte, but not in a wide string
+    String::CPtr e = String::create("\xc3\xa9");
+    String::CPtr we = String::create("\xc3\xa9\xe6\x97\xa5")->substring(0, 1);
+    ASSERT_TRUE(e->equals(we));
+    ASSERT_EQ(e->hashCode(), we->hashCode());
+
+    std::string s8(100, 'x');
+    String::CPtr s = String::create(s8.c_str());
+    String::CPtr half = String::create(s8.substr(50).c_str());
+    String::CPtr cons = half->concat(half);
+    String::CPtr slice = s->concat(half)->substring(50);
+    ASSERT_EQ(s->hashCode(), cons->hashCode());
+    ASSERT_EQ(s->hashCode(), slice->hashCode());
+
+    String::CPtr t = String::create(s8.c_str());
+    ASSERT_EQ(s->hashCode(), t->hashCode());
+    ASSERT_TRUE(s->equals(t));
+    ASSERT_FALSE(s->equals(slice->substring(1)));
+}
+
 TEST(GTestString, TestIsEmpty) {
     String::CPtr empty = String::create();
     ASSERT_TRUE(empty->isEmpty());
@@ -389,6 +493,28 @@ TEST(GTestString, TestIsInterned) {
     ASSERT_TRUE(interned123->isInterned());
 }
 
+TEST(GTestString, TestInternWeak) {
+    String::CPtr weak = String::intern(String::create("weak"), true);
+    ASSERT_TRUE(weak->isInterned());
+    ASSERT_EQ(weak, String::intern(String::create("weak"), true));
+    ASSERT_EQ(weak, String::intern("weak"));
+
+#ifdef LIBJ_USE_SP
+    detail::SymbolTable<detail::String> symbols;
+    for (Size i = 0; i < 1000; i++) {
+        symbols.intern(String::valueOf(static_cast<Long>(i)), true);
+    }
+    ASSERT_GT(1000, symbols.size());
+
+    String::CPtr sym = symbols.intern(str("x"), true);
+    for (Size i = 0; i < 1000; i++) {
+        symbols.intern(String::valueOf(static_cast<Long>(i)), false);
+    }
+    ASSERT_EQ(sym, symbols.intern(str("x"), true));
+    ASSERT_EQ(1001, symbols.size());
+#endif
+}
+
 TEST(GTestString, TestStartsWith) {
     String::CPtr s = String::create("abcde");
     String::CPtr s1 = String::create("abc");
@@ -461,6 +587,72 @@ TEST(GTestString, TestToUpperCase) {
     ASSERT_EQ(e, e->toUpperCase());
 }
 
+// covers both the vector loops and their scalar remainders
+TEST(GTestString, TestLongSearch) {
+    for (Size len = 1; len <= 70; len++) {
+        for (Size wide = 0; wide < 2; wide++) {
+            std::u32string s32(len, 'x');
+            if (wide) s32[len - 1] = 0x65e5;
+            for (Size i = 0; i + wide < len; i++) {
+                std::u32string t32(s32);
+                t32[i] = 'Y';
+                String::CPtr t = String::create(t32);
+                ASSERT_EQ(i, t->indexOf('Y'));
+                ASSERT_EQ(i, t->lastIndexOf('Y'));
+                ASSERT_EQ(NO_POS, t->indexOf('Y', i + 1));
+                ASSERT_EQ(i ? NO_POS : 0, t->lastIndexOf('Y', 0));
+
+                std::u32string l32(t32);
+                l32[i] = 'y';
+                ASSERT_TRUE(t->toLowerCase()->equals(String::create(l32)));
+                ASSERT_TRUE(t->replace('Y', 'y')->equals(String::create(l32)));
+
+                std::u32string u32(len, 'X');
+                u32[i] = 'Y';
+                if (wide) u32[len - 1] = 0x65e5;
+                ASSERT_TRUE(t->toUpperCase()->equals(String::create(u32)));
+            }
+        }
+    }
+}
+
+// compares with std::u32string::find, including characters
+// which share their low bytes in the shift table
+TEST(GTestString, TestLongPattern) {
+    const char32_t alphabet[] = { 'a', 'b', 0x161, 0x162 };
+    for (Size wide = 0; wide < 2; wide++) {
+        std::u32string s32;
+        UInt r = 12345;
+        for (Size i = 0; i < 1000; i++) {
+            r = r * 1103515245 + 12345;
+            s32 += alphabet[(r >> 16) % (wide ? 4 : 2)];
+        }
+        String::CPtr s = String::create(s32);
+        for (Size m = 8; m <= 300; m += 73) {
+            for (Size pos = 0; pos + m <= s32.length(); pos += 111) {
+                std::u32string p32 = s32.substr(pos, m);
+                String::CPtr p = String::create(p32);
+                for (Size from = 0; from < s32.length(); from += 250) {
+                    Size e = s32.find(p32, from);
+                    ASSERT_EQ(e == std::u32string::npos ? NO_POS : e,
+                              s->indexOf(p, from));
+                }
+            }
+        }
+    }
+}
+
+TEST(GTestString, TestReplaceLongPattern) {
+    String::CPtr p = String::create("abcdefghij");
+    String::CPtr s = String::create("x");
+    String::CPtr e = String::create("x");
+    for (Size i = 0; i < 40; i++) {
+        s = s->concat(p)->concat(String::create("y"));
+        e = e->concat(String::create("zy"));
+    }
+    ASSERT_TRUE(s->replace(p, String::create("z"))->equals(e));
+}
+
 TEST(GTestString, TestToString) {
     String::CPtr s = String::create("abcabc");
     ASSERT_TRUE(s->toString()->equals(s));
@@ -516,6 +708,33 @@ TEST(GTestString, TestValueOf) {
     v = size;
     ASSERT_TRUE(String::valueOf(v)->equals(String::create("1234567890")));
 
+    v = static_cast<Int>(0x80000000);
+    ASSERT_TRUE(String::valueOf(v)->equals(String::create("-2147483648")));
+
+    v = static_cast<Long>(0x8000000000000000LL);
+    ASSERT_TRUE(String::valueOf(v)->equals(
+        String::create("-9223372036854775808")));
+
+    v = static_cast<ULong>(-1);
+    ASSERT_TRUE(String::valueOf(v)->equals(
+        String::create("18446744073709551615")));
+
+    v = 0;
+    ASSERT_TRUE(String::valueOf(v)->equals(String::create("0")));
+
+    v = 42.0;
+    ASSERT_TRUE(String::valueOf(v)->equals(String::create("42")));
+
+    v = -0.0;
+    ASSERT_TRUE(String::valueOf(v)->equals(String::create("0")));
+
+    v = 9007199254740991.0;
+    ASSERT_TRUE(String::valueOf(v)->equals(
+        String::create("9007199254740991")));
+
+    v = 0.1;
+    ASSERT_TRUE(String::valueOf(v)->equals(String::create("0.1")));
+
     String::CPtr s = String::create("abc");
     v = s;
     ASSERT_TRUE(String::valueOf(v)->equals(s));
@@ -567,6 +786,67 @@ TEST(GTestString, TestToStdString) {
     ASSERT_TRUE(s8->equals(s3));
 }
 
+TEST(GTestString, TestMixedWidth) {
+    // "\u00e9t\u00e9" fits in one byte per character, "\u65e5" does not
+    String::CPtr latin1 = String::create("\xc3\xa9t\xc3\xa9");
+    String::CPtr wide = String::create(
+        "\xc3\xa9t\xc3\xa9\xe6\x97\xa5");
+    ASSERT_EQ(3, latin1->length());
+    ASSERT_EQ(4, wide->length());
+    ASSERT_EQ(0xe9, latin1->charAt(0));
+    ASSERT_EQ(0x65e5, wide->charAt(3));
+
+    String::CPtr head = wide->substring(0, 3);
+    ASSERT_TRUE(head->equals(latin1));
+    ASSERT_TRUE(latin1->equals(head));
+    ASSERT_EQ(0, latin1->compareTo(head));
+    ASSERT_GT(0, latin1->compareTo(wide));
+    ASSERT_LT(0, wide->compareTo(latin1));
+    ASSERT_TRUE(wide->startsWith(latin1));
+    ASSERT_EQ(0, wide->indexOf(latin1));
+    ASSERT_EQ(0, wide->lastIndexOf(latin1));
+    ASSERT_EQ(NO_POS, latin1->indexOf(wide));
+    ASSERT_EQ(NO_POS, latin1->indexOf(static_cast<Char>(0x65e5)));
+    ASSERT_EQ(2, latin1->lastIndexOf(static_cast<Char>(0xe9)));
+
+    String::CPtr s = latin1->concat(wide);
+    ASSERT_EQ(7, s->length());
+    ASSERT_TRUE(s->endsWith(wide));
+    ASSERT_EQ(0x65e5, s->charAt(6));
+    ASSERT_TRUE(latin1->replace(
+        static_cast<Char>(0xe9), static_cast<Char>(0x65e5))->equals(
+            String::create("\xe6\x97\xa5t\xe6\x97\xa5")));
+    ASSERT_EQ(std::string("\xc3\xa9t\xc3\xa9"), latin1->toStdString());
+}
+
+TEST(GTestString, TestLongString) {
+    std::string s8(1000, 'a');
+    String::CPtr s = String::create(s8.c_str());
+    ASSERT_EQ(1000, s->length());
+    ASSERT_EQ('a', s->charAt(999));
+    ASSERT_EQ(NO_CHAR, s->charAt(1000));
+    ASSERT_EQ(s8, s->toStdString());
+
+    String::CPtr s2 = s->concat(String::create("b"));
+    ASSERT_EQ(1001, s2->length());
+    ASSERT_EQ(1000, s2->indexOf('b'));
+    ASSERT_TRUE(s2->startsWith(s));
+    ASSERT_TRUE(s2->substring(1)->endsWith(String::create("ab")));
+    ASSERT_TRUE(s2->toUpperCase()->startsWith(String::create("AAA")));
+}
+
+TEST(GTestString, TestData) {
+    String::CPtr s = String::create("abc");
+    const Char* d = s->data();
+    ASSERT_EQ('a', d[0]);
+    ASSERT_EQ('c', d[2]);
+    ASSERT_EQ(0, d[3]);
+    ASSERT_EQ(d, s->data());
+
+    String::CPtr empty = String::create();
+    ASSERT_EQ(0, empty->data()[0]);
+}
+
 TEST(GTestString, TestStr) {
     ASSERT_EQ(String::create(), str());
     ASSERT_NE(String::create("abc"), str("abc"));
@@ -577,4 +857,167 @@ TEST(GTestString, TestStr) {
 #endif
 }
 
+static Boolean isNegativeZero(Double d) {
+    return d == 0 && 1 / d < 0;
+}
+
+TEST(GTestString, TestParseInt) {
+    ASSERT_EQ(123, parseInt(str("123")));
+    ASSERT_EQ(-123, parseInt(str(" \t\n-123abc")));
+    ASSERT_EQ(255, parseInt(str("0xff")));
+    ASSERT_EQ(255, parseInt(str("0XFF"), 16));
+    ASSERT_EQ(0, parseInt(str("0xff"), 10));
+    ASSERT_EQ(5, parseInt(str("101"), 2));
+    ASSERT_EQ(35, parseInt(str("z"), 36));
+    ASSERT_EQ(12, parseInt(str("12.9")));
+    ASSERT_EQ(1e21, parseInt(str("1000000000000000000000")));
+    ASSERT_EQ(18446744073709551616.0,
+              parseInt(str("10000000000000000"), 16));
+    ASSERT_TRUE(isNegativeZero(parseInt(str("-0"))));
+
+    Double nan = parseInt(str("abc"));
+    ASSERT_NE(nan, nan);
+    nan = parseInt(str("0x"));
+    ASSERT_NE(nan, nan);
+    nan = parseInt(str("1"), 37);
+    ASSERT_NE(nan, nan);
+    nan = parseInt(String::null());
+    ASSERT_NE(nan, nan);
+
+    String::CPtr wide = String::create(0x3000, 1)->concat(str("-42"));
+    ASSERT_EQ(-42, parseInt(wide));
+}
+
+TEST(GTestString, TestParseFloat) {
+    ASSERT_EQ(3.14, parseFloat(str("3.14")));
+    ASSERT_EQ(-0.5, parseFloat(str("  -.5abc")));
+    ASSERT_EQ(100, parseFloat(str("1e2")));
+    ASSERT_EQ(1, parseFloat(str("1e")));
+    ASSERT_EQ(1, parseFloat(str("1.e+x")));
+    ASSERT_EQ(POSITIVE_INFINITY, parseFloat(str("Infinityx")));
+    ASSERT_EQ(NEGATIVE_INFINITY, parseFloat(str("-Infinity")));
+    ASSERT_EQ(0, parseFloat(str("0x10")));
+    ASSERT_TRUE(isNegativeZero(parseFloat(str("-0.0"))));
+
+    // correctly rounded
+    ASSERT_EQ(0.1, parseFloat(str("0.1")));
+    ASSERT_EQ(1.7976931348623157e308,
+              parseFloat(str("1.7976931348623157e308")));
+    ASSERT_EQ(POSITIVE_INFINITY, parseFloat(str("1.8e308")));
+    ASSERT_EQ(2.2250738585072014e-308,
+              parseFloat(str("2.2250738585072014e-308")));
+    ASSERT_EQ(4.9406564584124654e-324,
+              parseFloat(str("4.9406564584124654e-324")));
+    ASSERT_EQ(0, parseFloat(str("2e-324")));
+    ASSERT_EQ(9007199254740992.0, parseFloat(str("9007199254740993")));
+    ASSERT_EQ(9007199254740994.0,
+              parseFloat(str("9007199254740993.0000000000000000001")));
+    ASSERT_EQ(7.2057594037927933e16,
+              parseFloat(str("72057594037927933")));
+    ASSERT_EQ(1e23, parseFloat(str("1e23")));
+    ASSERT_EQ(8.98846567431158e307,
+              parseFloat(str("8.98846567431158e307")));
+
+    Double nan = parseFloat(str("."));
+    ASSERT_NE(nan, nan);
+    nan = parseFloat(str("e1"));
+    ASSERT_NE(nan, nan);
+}
+
+TEST(GTestString, TestToNumber) {
+    ASSERT_EQ(0, toNumber(str("")));
+    ASSERT_EQ(0, toNumber(str(" \r\n ")));
+    ASSERT_EQ(12.5, toNumber(str(" 12.5 ")));
+    ASSERT_EQ(16, toNumber(str("0x10")));
+    ASSERT_EQ(0.5, toNumber(str(".5")));
+    ASSERT_EQ(5, toNumber(str("5.")));
+    ASSERT_EQ(POSITIVE_INFINITY, toNumber(str("+Infinity")));
+    ASSERT_EQ(1e-7, toNumber(str("1E-7")));
+
+    Double nan = toNumber(str("12px"));
+    ASSERT_NE(nan, nan);
+    nan = toNumber(str("1e"));
+    ASSERT_NE(nan, nan);
+    nan = toNumber(str("-0x10"));
+    ASSERT_NE(nan, nan);
+    nan = toNumber(str("0x1g"));
+    ASSERT_NE(nan, nan);
+    nan = toNumber(str("infinity"));
+    ASSERT_NE(nan, nan);
+}
+
+TEST(GTestString, TestParseLong) {
+    Long l = 0;
+    ASSERT_TRUE(parseLong(str("1234567890123"), &l));
+    ASSERT_EQ(1234567890123LL, l);
+    ASSERT_TRUE(parseLong(str("+7"), &l));
+    ASSERT_EQ(7, l);
+    ASSERT_TRUE(parseLong(str("9223372036854775807"), &l));
+    ASSERT_EQ(9223372036854775807LL, l);
+    ASSERT_TRUE(parseLong(str("-9223372036854775808"), &l));
+    ASSERT_EQ(-9223372036854775807LL - 1, l);
+
+    l = 1;
+    ASSERT_FALSE(parseLong(str("9223372036854775808"), &l));
+    ASSERT_FALSE(parseLong(str("-9223372036854775809"), &l));
+    ASSERT_FALSE(parseLong(str(""), &l));
+    ASSERT_FALSE(parseLong(str("-"), &l));
+    ASSERT_FALSE(parseLong(str(" 1"), &l));
+    ASSERT_FALSE(parseLong(str("1.0"), &l));
+    ASSERT_FALSE(parseLong(String::null(), &l));
+    ASSERT_EQ(1, l);
+}
+
+TEST(GTestString, TestSplit) {
+    JsArray::Ptr a = str("a,b,,c")->split(',');
+    ASSERT_TRUE(a->toString()->equals(str("a,b,,c")));
+    ASSERT_EQ(4, a->length());
+    ASSERT_TRUE(a->getCPtr<String>(2)->isEmpty());
+
+    a = str("a,b,,c")->split(',', 2);
+    ASSERT_EQ(2, a->length());
+    ASSERT_TRUE(a->getCPtr<String>(1)->equals(str("b")));
+    ASSERT_EQ(0, str("a,b")->split(',', 0)->length());
+    ASSERT_EQ(1, str("")->split(',')->length());
+
+    a = str("a::b::")->split(str("::"));
+    ASSERT_EQ(3, a->length());
+    ASSERT_TRUE(a->getCPtr<String>(0)->equals(str("a")));
+    ASSERT_TRUE(a->getCPtr<String>(2)->isEmpty());
+
+    a = str("abc")->split(str(""));
+    ASSERT_TRUE(a->join(str("|"))->equals(str("a|b|c")));
+    ASSERT_EQ(0, str("")->split(str(""))->length());
+
+    a = str("abc")->split(String::null());
+    ASSERT_EQ(1, a->length());
+    ASSERT_TRUE(a->getCPtr<String>(0)->equals(str("abc")));
+
+    String::CPtr sep = String::create('-', 300);
+    a = str("x")->concat(sep)->concat(str("y"))->concat(sep)->split(sep);
+    ASSERT_TRUE(a->join()->equals(str("x,y,")));
+
+    a = str("\xe3\x81\x82,\xe3\x81\x84")->split(',');
+    ASSERT_TRUE(a->getCPtr<String>(1)->equals(str("\xe3\x81\x84")));
+}
+
+TEST(GTestString, TestSplitShare) {
+    String::CPtr s = String::create('a', 20)
+        ->concat(str(","))->concat(String::create('b', 100));
+    JsArray::Ptr a = s->split(',', NO_SIZE, true);
+    ASSERT_EQ(2, a->length());
+    ASSERT_TRUE(a->getCPtr<String>(0)->equals(String::create('a', 20)));
+    ASSERT_TRUE(a->getCPtr<String>(1)->equals(String::create('b', 100)));
+
+    a = s->split(',');
+    ASSERT_TRUE(a->getCPtr<String>(0)->equals(String::create('a', 20)));
+}
+
+TEST(GTestString, TestSplitRegExp) {
+    JsRegExp::Ptr re = JsRegExp::create(str("\\s*(,)\\s*"));
+    JsArray::Ptr a = str("a , b,c")->split(re);
+    ASSERT_EQ(5, a->length());
+    ASSERT_TRUE(a->join(str("|"))->equals(str("a|,|b|,|c")));
+}
+
 }  // namespace libj
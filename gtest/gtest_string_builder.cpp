@@ -2,9 +2,29 @@
 
 #include <gtest/gtest.h>
 #include <libj/string_builder.h>
+#include <libj/glue/cvtutf.h>
+
+#include <stdlib.h>
+#include <new>
 
 #pragma GCC diagnostic ignored "-Wnarrowing"
 
+// the size of the largest array allocated while it is not NULL
+static size_t* gtestMaxNewArraySize = NULL;
+
+void* operator new[](size_t size) {
+    if (gtestMaxNewArraySize && *gtestMaxNewArraySize < size) {
+        *gtestMaxNewArraySize = size;
+    }
+    void* p = malloc(size ? size : 1);
+    if (!p) throw std::bad_alloc();
+    return p;
+}
+
+void operator delete[](void* p) throw() {
+    free(p);
+}
+
 namespace libj {
 
 TEST(GTestStringBuilder, TestCharAt) {
@@ -100,6 +120,25 @@ TEST(GTestStringBuilder, TestAppendManyTimes) {
     ASSERT_TRUE(sb->toString()->equals(exp));
 }
 
+TEST(GTestStringBuilder, TestAppendNumber) {
+    StringBuilder::Ptr sb = StringBuilder::create();
+    sb->append(0);
+    sb->appendChar(',');
+    sb->append(-1234567890);
+    sb->appendChar(',');
+    sb->append(static_cast<ULong>(12345678901234567890ULL));
+    sb->appendChar(',');
+    sb->append(static_cast<Byte>(-128));
+    sb->appendChar(',');
+    sb->append(-2.5);
+    sb->appendChar(',');
+    sb->append(static_cast<Float>(100));
+    sb->appendChar(',');
+    sb->append(1e21);
+    ASSERT_TRUE(sb->toString()->equals(String::create(
+        "0,-1234567890,12345678901234567890,-128,-2.5,100,1e+21")));
+}
+
 TEST(GTestStringBuilder, TestAppendChar) {
     StringBuilder::Ptr sb = StringBuilder::create();
     ASSERT_EQ(sb, sb->appendChar('a'));
@@ -132,6 +171,98 @@ TEST(GTestStringBuilder, TestAppendStr3) {
     ASSERT_TRUE(sb->toString()->equals(String::create("abcnull123")));
 }
 
+TEST(GTestStringBuilder, TestAppendUtf8) {
+    const char u8[] = {
+        0x31,              // 1
+        0xe3, 0x81, 0x82,  // a
+        0xe3, 0x81, 0x84,  // i
+        0x32,              // 2
+        0xe3, 0x81,
+    };
+
+    glue::Utf8Decoder decoder;
+    StringBuilder::Ptr sb = StringBuilder::create();
+    ASSERT_EQ(sb, sb->appendUtf8(&decoder, u8, 3));
+    ASSERT_EQ(1, sb->length());
+    ASSERT_EQ(sb, sb->appendUtf8(&decoder, u8 + 3, 5));
+    ASSERT_EQ(4, sb->length());
+    ASSERT_EQ(sb, sb->appendUtf8(&decoder, u8 + 8, 2));
+    ASSERT_EQ(4, sb->length());
+    ASSERT_EQ(sb, sb->appendUtf8(&decoder, NULL, 0));
+    ASSERT_EQ(5, sb->length());
+    ASSERT_EQ(0x3044, sb->charAt(2));
+    ASSERT_EQ(0xfffd, sb->charAt(4));
+
+    String::CPtr s = String::create(u8, String::UTF8, 8);
+    ASSERT_TRUE(sb->toString()->startsWith(s));
+}
+
+TEST(GTestStringBuilder, TestReserve) {
+    StringBuilder::Ptr sb = StringBuilder::create();
+    ASSERT_EQ(0, sb->capacity());
+    sb->reserve(100);
+    ASSERT_EQ(100, sb->capacity());
+    sb->appendStr("abc");
+    sb->reserve(10);
+    ASSERT_EQ(100, sb->capacity());
+    ASSERT_TRUE(sb->toString()->equals(String::create("abc")));
+
+    for (Size i = 0; i < 200; i++) {
+        sb->appendChar('x');
+    }
+    ASSERT_EQ(203, sb->length());
+    ASSERT_LE(203, sb->capacity());
+}
+
+TEST(GTestStringBuilder, TestBuild) {
+    StringBuilder::Ptr sb = StringBuilder::create();
+    ASSERT_TRUE(sb->build()->isEmpty());
+
+    sb->appendStr("abc");
+    ASSERT_TRUE(sb->build()->equals(String::create("abc")));
+    ASSERT_EQ(0, sb->length());
+
+    std::u16string s16(100, 'a');
+    s16 += 0x3042;
+    String::CPtr s1 = String::create(std::string(100, 'a').c_str());
+    String::CPtr s2 = String::create(s16);
+    sb->append(s1);
+    String::CPtr s = sb->build();
+    ASSERT_TRUE(s->equals(s1));
+    ASSERT_EQ(s1->hashCode(), s->hashCode());
+    ASSERT_EQ(0, sb->length());
+    ASSERT_EQ(0, sb->data()[0]);
+
+    sb->append(s1);
+    sb->appendChar(0x3042);
+    s = sb->build();
+    ASSERT_TRUE(s->equals(s2));
+    ASSERT_TRUE(s->toString()->equals(s2));
+
+    sb->reserve(1000);
+    sb->append(s1);
+    ASSERT_TRUE(sb->build()->equals(s1));
+    ASSERT_EQ(1000, sb->capacity());
+    sb->append(s2);
+    ASSERT_TRUE(sb->build()->equals(s2));
+}
+
+TEST(GTestStringBuilder, TestBuildOneByte) {
+    StringBuilder::Ptr sb = StringBuilder::create();
+    sb->reserve(100);
+    for (Size i = 0; i < 60; i++) {
+        sb->appendChar('a');
+    }
+
+    size_t size = 0;
+    gtestMaxNewArraySize = &size;
+    String::CPtr s = sb->build();
+    gtestMaxNewArraySize = NULL;
+    ASSERT_EQ(61, size);
+    ASSERT_TRUE(s->equals(String::create(std::string(60, 'a').c_str())));
+    ASSERT_EQ(100, sb->capacity());
+}
+
 TEST(GTestStringBuilder, TestData) {
     StringBuilder::Ptr sb = StringBuilder::create();
     sb->appendChar('a');
@@ -0,0 +1,66 @@
+// Copyright (c) 2013 Plenluno All rights reserved.
+
+#include <gtest/gtest.h>
+#include <libj/string_searcher.h>
+
+#include <string>
+
+namespace libj {
+
+TEST(GTestStringSearcher, TestCreate) {
+    StringSearcher::CPtr s = StringSearcher::create(String::create("abc"));
+    ASSERT_TRUE(!!s);
+
+    s = StringSearcher::create(String::null());
+    ASSERT_FALSE(s);
+}
+
+TEST(GTestStringSearcher, TestPattern) {
+    String::CPtr p = String::create("abc");
+    StringSearcher::CPtr s = StringSearcher::create(p);
+    ASSERT_EQ(p, s->pattern());
+    ASSERT_TRUE(s->toString()->equals(p));
+}
+
+TEST(GTestStringSearcher, TestSearch) {
+    StringSearcher::CPtr s = StringSearcher::create(String::create("bc"));
+    String::CPtr str = String::create("abcabc");
+    ASSERT_EQ(1, s->search(str));
+    ASSERT_EQ(4, s->search(str, 2));
+    ASSERT_EQ(NO_POS, s->search(str, 5));
+    ASSERT_EQ(NO_POS, s->search(String::null()));
+}
+
+TEST(GTestStringSearcher, TestSearch2) {
+    String::CPtr p = String::create("0123456789");
+    StringSearcher::CPtr s = StringSearcher::create(p);
+    String::CPtr str = String::create("01234567890123456789");
+    ASSERT_EQ(0, s->search(str));
+    ASSERT_EQ(10, s->search(str, 1));
+    ASSERT_EQ(NO_POS, s->search(str, 11));
+
+    String::CPtr wide = String::create("\xe6\x97\xa5")->concat(str);
+    ASSERT_EQ(1, s->search(wide));
+    ASSERT_EQ(11, s->search(wide, 2));
+}
+
+TEST(GTestStringSearcher, TestSearchLong) {
+    std::string p8;
+    for (Size i = 0; i < 300; i++) p8 += static_cast<char>('a' + i % 26);
+    String::CPtr p = String::create(p8.c_str());
+    StringSearcher::CPtr s = StringSearcher::create(p);
+    String::CPtr str = String::create((p8 + p8.substr(1) + p8).c_str());
+    ASSERT_EQ(0, s->search(str));
+    ASSERT_EQ(599, s->search(str, 1));
+    ASSERT_EQ(NO_POS, s->search(str, 600));
+    ASSERT_EQ(NO_POS, s->search(p->substring(1)));
+}
+
+TEST(GTestStringSearcher, TestInstanceOf) {
+    StringSearcher::CPtr s = StringSearcher::create(String::create("abc"));
+    ASSERT_TRUE(s->instanceof(Type<StringSearcher>::id()));
+    ASSERT_TRUE(s->instanceof(Type<Immutable>::id()));
+    ASSERT_TRUE(s->instanceof(Type<Object>::id()));
+}
+
+}  // namespace libj
@@ -104,4 +104,15 @@ TEST(GTestTypedJsArray, TestSubList) {
 #endif  // LIBJ_USE_EXCEPTION
 }
 
+TEST(GTestTypedJsArray, TestJoin) {
+    TypedJsArray<Int>::Ptr a = TypedJsArray<Int>::create();
+    ASSERT_TRUE(a->join()->equals(String::create()));
+
+    a->addTyped(3);
+    a->addTyped(5);
+    ASSERT_TRUE(a->join()->equals(String::create("3,5")));
+    String::CPtr plus = String::create(" + ");
+    ASSERT_TRUE(a->join(plus)->equals(String::create("3 + 5")));
+}
+
 }  // namespace libj
@@ -3,6 +3,7 @@
 #include <gtest/gtest.h>
 #include <boost/any.hpp>
 #include <libj/array_list.h>
+#include <libj/constant.h>
 #include <libj/singleton.h>
 #include <libj/string.h>
 #include <libj/value.h>
@@ -738,6 +739,92 @@ TEST(GTestValue, TestType) {
     ASSERT_EQ(0, UNDEFINED.type());
 }
 
+TEST(GTestValue, TestCopyAndAssign) {
+    String::CPtr abc = String::create("abc");
+    Value v1 = abc;
+    Value v2 = v1;
+    Value v3;
+    v3 = v2;
+    v2 = 5;
+    ASSERT_TRUE(v1.equals(abc));
+    ASSERT_TRUE(v3.equals(abc));
+    ASSERT_EQ(5, to<int>(v2));
+
+    v1.swap(v2);
+    ASSERT_EQ(5, to<int>(v1));
+    ASSERT_TRUE(v2.equals(abc));
+
+    v3 = v3;
+    ASSERT_TRUE(v3.equals(abc));
+
+    v3 = UNDEFINED;
+    ASSERT_TRUE(v3.isUndefined());
+}
+
+TEST(GTestValue, TestTypeAfterAssign) {
+    Value v = String::null();
+    ASSERT_TRUE(v.isNull());
+    ASSERT_EQ(1, v.type());
+
+    v = 3;
+    ASSERT_TRUE(v.isPrimitive());
+    ASSERT_TRUE(v.is<int>());
+    ASSERT_EQ(Type<int>::id(), v.type());
+
+    Value s = String::create("abc");
+    v.swap(s);
+    ASSERT_TRUE(v.isObject());
+    ASSERT_TRUE(v.isCPtr());
+    ASSERT_FALSE(v.isPtr());
+    ASSERT_TRUE(v.is<String>());
+    ASSERT_TRUE(s.is<int>());
+
+    v = ArrayList::create();
+    ASSERT_TRUE(v.isPtr());
+    ASSERT_FALSE(v.isCPtr());
+    ASSERT_TRUE(v.is<List>());
+
+    Value u;
+    v = u;
+    ASSERT_TRUE(v.isUndefined());
+    ASSERT_EQ(0, v.type());
+}
+
+TEST(GTestValue, TestLargeValue) {
+    typedef long double LongDouble;
+    Value v1 = static_cast<LongDouble>(1.5);
+    Value v2 = v1;
+    Value v3 = 3;
+    v3.swap(v2);
+    ASSERT_TRUE(v3.is<LongDouble>());
+    ASSERT_EQ(static_cast<LongDouble>(1.5), to<LongDouble>(v3));
+    ASSERT_EQ(3, to<int>(v2));
+    ASSERT_TRUE(v1.equals(v3));
+}
+
+#ifdef LIBJ_USE_CXX11
+TEST(GTestValue, TestMove) {
+    String::CPtr abc = String::create("abc");
+    Value v1 = abc;
+    Value v2 = std::move(v1);
+    ASSERT_TRUE(v1.isUndefined());
+    ASSERT_TRUE(v2.equals(abc));
+
+    Value v3 = 3;
+    v3 = std::move(v2);
+    ASSERT_TRUE(v2.isUndefined());
+    ASSERT_TRUE(v3.equals(abc));
+
+    v3 = std::move(v3);
+    ASSERT_TRUE(v3.equals(abc));
+
+    String::CPtr def = String::create("def");
+    v1 = std::move(def);
+    ASSERT_FALSE(def);
+    ASSERT_TRUE(v1.equals(String::create("def")));
+}
+#endif
+
 TEST(GTestValue, TestIs) {
     int i = 2;
     Value v1 = i;
@@ -753,4 +840,35 @@ TEST(GTestValue, TestIs) {
     ASSERT_FALSE(null.is<String>());
 }
 
+TEST(GTestValue, TestHashCode) {
+    Value v1 = String::create("abc");
+    Value v2 = String::create("abc");
+    ASSERT_EQ(v1.hashCode(), v2.hashCode());
+
+    Value d1 = 0.0;
+    Value d2 = -0.0;
+    ASSERT_EQ(d1.hashCode(), d2.hashCode());
+
+    Value i1 = 123;
+    Value i2 = 123;
+    ASSERT_EQ(i1.hashCode(), i2.hashCode());
+
+    ASSERT_EQ(Value(String::null()).hashCode(), Value(ArrayList::null()).hashCode());
+    ASSERT_NE(Value().hashCode(), Value(String::null()).hashCode());
+}
+
+TEST(GTestValue, TestNaN) {
+    Value nan = QUIET_NAN;
+    ASSERT_TRUE(nan.equals(QUIET_NAN));
+    ASSERT_EQ(nan.hashCode(), Value(QUIET_NAN).hashCode());
+    ASSERT_FALSE(nan.equals(1.0));
+    ASSERT_FALSE(Value(1.0).equals(nan));
+    ASSERT_TRUE(nan > 1.0);
+    ASSERT_TRUE(Value(1.0) < nan);
+
+    Value fnan = static_cast<Float>(QUIET_NAN);
+    ASSERT_TRUE(fnan.equals(static_cast<Float>(QUIET_NAN)));
+    ASSERT_FALSE(fnan.equals(static_cast<Float>(1)));
+}
+
 }  // namespace libj
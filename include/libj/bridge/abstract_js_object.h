@@ -32,6 +32,18 @@ class AbstractJsObject : public AbstractMap<I> {
         return obj_->deleteProperty(name);
     }
 
+    virtual Boolean hasProperty(const JsPropertyKey& key) const {
+        return obj_->hasProperty(key);
+    }
+
+    virtual Value getProperty(const JsPropertyKey& key) const {
+        return obj_->getProperty(key);
+    }
+
+    virtual Value setProperty(const JsPropertyKey& key, const Value& val) {
+        return obj_->setProperty(key, val);
+    }
+
     virtual String::CPtr toString() const {
         return obj_->toString();
     }
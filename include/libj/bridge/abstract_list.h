@@ -73,6 +73,23 @@ class AbstractList : public AbstractCollection<I> {
         return list_->pop();
     }
 
+#ifdef LIBJ_USE_CXX11
+ public:
+    // go through the overloads taking const Value&,
+    // so that a subclass overriding them sees every call
+    virtual Boolean add(Value&& v) {
+        return this->add(v);
+    }
+
+    virtual Boolean add(Size i, Value&& v) {
+        return this->add(i, v);
+    }
+
+    virtual Size push(Value&& val) {
+        return this->push(val);
+    }
+#endif
+
  private:
     List::Ptr list_;
 };
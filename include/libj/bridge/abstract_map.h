@@ -48,10 +48,24 @@ class AbstractMap : public I {
         return map_->put(key, val);
     }
 
+#ifdef LIBJ_USE_CXX11
+    // goes through put(const Value&, const Value&),
+    // so that a subclass overriding it sees every put
+    virtual Value put(Value&& key, Value&& val) {
+        return this->put(key, val);
+    }
+#endif
+
     virtual Value remove(const Value& key) {
         return map_->remove(key);
     }
 
+    virtual void putAll(Map::CPtr map) {
+        if (!map || &(*map) == this) return;
+
+        map_->putAll(map);
+    }
+
     virtual Size size() const {
         return map_->size();
     }
@@ -3,13 +3,35 @@
 #ifndef LIBJ_CONCURRENT_MAP_H_
 #define LIBJ_CONCURRENT_MAP_H_
 
+#include <libj/function.h>
 #include <libj/map.h>
 
 namespace libj {
 
+// the following are atomic with respect to the other operations on key.
+// func is called under the lock of key, and must not access this map.
+// putAll is atomic as well; no operation on a key sees some of
+// the entries put and not the others.
 class ConcurrentMap : LIBJ_MAP(ConcurrentMap)
  public:
     static Ptr create();
+
+    // returns the current value, or puts val and returns UNDEFINED
+    // if key is absent
+    virtual Value putIfAbsent(const Value& key, const Value& val) = 0;
+
+    // puts newVal only if key is mapped to a value equal to oldVal
+    virtual Boolean replace(
+        const Value& key, const Value& oldVal, const Value& newVal) = 0;
+
+    // returns the current value, or puts and returns func(key)
+    // if key is absent. nothing is put if func returns UNDEFINED.
+    virtual Value computeIfAbsent(const Value& key, Function::Ptr func) = 0;
+
+    // puts val if key is absent, and func(oldVal, val) otherwise.
+    // removes key if func returns UNDEFINED. returns the new value.
+    virtual Value merge(
+        const Value& key, const Value& val, Function::Ptr func) = 0;
 };
 
 }  // namespace libj
@@ -0,0 +1,55 @@
+// Copyright (c) 2013 Plenluno All rights reserved.
+
+#ifndef LIBJ_DETAIL_ANCESTRY_H_
+#define LIBJ_DETAIL_ANCESTRY_H_
+
+#include <libj/detail/type.h>
+
+namespace libj {
+namespace detail {
+
+// an ancestry is the list of the TypeIds of a class and its ancestors,
+// indexed by their levels, with the level of the class at index 0.
+// it is never freed so that instanceof stays usable
+// while static objects are being destroyed.
+inline const TypeId* createAncestry(TypeId id, const TypeId* base = 0) {
+    Size level = base ? base[0] + 1 : 1;
+    TypeId* ids = new TypeId[level + 1];
+    ids[0] = level;
+    for (Size i = 1; i < level; i++) {
+        ids[i] = base[i];
+    }
+    ids[level] = id;
+#ifdef LIBJ_USE_THREAD
+    reinterpret_cast<TypeInfo*>(id)->level.store(
+        level, LIBJ_DETAIL_MEMORY_ORDER(release));
+#else
+    reinterpret_cast<TypeInfo*>(id)->level = level;
+#endif
+    return ids;
+}
+
+inline Boolean inAncestry(const TypeId* ancestry, TypeId id) {
+    if (id <= 1) return false;
+
+#ifdef LIBJ_USE_THREAD
+    Size level = reinterpret_cast<const TypeInfo*>(id)->level.load(
+        LIBJ_DETAIL_MEMORY_ORDER(acquire));
+#else
+    Size level = reinterpret_cast<const TypeInfo*>(id)->level;
+#endif
+    return level && level <= ancestry[0] && ancestry[level] == id;
+}
+
+}  // namespace detail
+}  // namespace libj
+
+#define LIBJ_ANCESTRY_DEF(T, B) \
+    static const libj::TypeId* ancestry() { \
+        static const libj::TypeId* a = \
+            libj::detail::createAncestry( \
+                libj::Type<T >::id(), B::ancestry()); \
+        return a; \
+    }
+
+#endif  // LIBJ_DETAIL_ANCESTRY_H_
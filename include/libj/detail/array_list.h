@@ -19,6 +19,16 @@ class ArrayList : public GenericArrayList<I, Value> {
         return GenericArrayList<I, Value>::addTyped(i, v);
     }
 
+#ifdef LIBJ_USE_CXX11
+    virtual Boolean add(Value&& v) {
+        return GenericArrayList<I, Value>::addTyped(std::move(v));
+    }
+
+    virtual Boolean add(Size i, Value&& v) {
+        return GenericArrayList<I, Value>::addTyped(i, std::move(v));
+    }
+#endif
+
     virtual Boolean set(Size i, const Value& v) {
         return GenericArrayList<I, Value>::setTyped(i, v);
     }
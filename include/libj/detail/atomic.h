@@ -8,9 +8,11 @@
 #ifdef LIBJ_USE_CXX11
 # include <atomic>
 # define LIBJ_DETAIL_ATOMIC(T) std::atomic<T>
+# define LIBJ_DETAIL_MEMORY_ORDER(O) std::memory_order_##O
 #else
 # include <boost/atomic.hpp>
 # define LIBJ_DETAIL_ATOMIC(T) boost::atomic<T>
+# define LIBJ_DETAIL_MEMORY_ORDER(O) boost::memory_order_##O
 #endif
 
 #endif  // LIBJ_DETAIL_ATOMIC_H_
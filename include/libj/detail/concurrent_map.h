@@ -3,67 +3,338 @@
 #ifndef LIBJ_DETAIL_CONCURRENT_MAP_H_
 #define LIBJ_DETAIL_CONCURRENT_MAP_H_
 
-#include <libj/detail/map.h>
+#include <libj/typed_set.h>
+#include <libj/string_builder.h>
+#include <libj/detail/hash_table.h>
+#include <libj/detail/map_view.h>
 #include <libj/detail/scoped_lock.h>
 
+#include <vector>
+
 namespace libj {
 namespace detail {
 
+// the entries are split into stripes by the high bits of their hashes.
+// each stripe has its own lock, so that threads accessing different
+// stripes do not contend.
+//
+// the methods on the whole map lock the stripes one at a time,
+// except putAll, which locks all of them in order.
+// the iterators copy a stripe at a time under its lock, and never fail
+// on concurrent updates. they reflect the state of each stripe at some
+// point since the iterator was created (weakly consistent).
 template<typename I>
-class ConcurrentMap : public Map<I> {
+class ConcurrentMap : public I {
+ private:
+    struct Slot {
+        Value key;
+        Value val;
+    };
+
+    typedef HashTable<Slot> Container;
+
+    typedef typename I::Entry EntryT;
+    typedef TypedSet<typename EntryT::CPtr> EntrySetT;
+    typedef TypedIterator<typename EntryT::CPtr> EntryIteratorT;
+
  public:
     virtual Size size() const {
-        ScopedLock lock(mutex_);
-        return Map<I>::size();
+        Size n = 0;
+        for (Size i = 0; i < NUM_STRIPES; i++) {
+            ScopedLock lock(stripes_[i].mutex);
+            n += stripes_[i].map.size();
+        }
+        return n;
     }
 
     virtual Boolean containsKey(const Value& key) const {
-        ScopedLock lock(mutex_);
-        return Map<I>::containsKey(key);
+        Stripe& s = stripeOf(key);
+        ScopedLock lock(s.mutex);
+        return !!s.map.find(key);
     }
 
     virtual Boolean containsValue(const Value& val) const {
-        ScopedLock lock(mutex_);
-        return Map<I>::containsValue(val);
+        for (Size i = 0; i < NUM_STRIPES; i++) {
+            Stripe& s = stripes_[i];
+            ScopedLock lock(s.mutex);
+            Size n = s.map.capacity();
+            for (Size j = s.map.next(0); j < n; j = s.map.next(j + 1)) {
+                if (!s.map.at(j).val.compareTo(val))
+                    return true;
+            }
+        }
+        return false;
     }
 
     virtual Value get(const Value& key) const {
-        ScopedLock lock(mutex_);
-        return Map<I>::get(key);
+        Stripe& s = stripeOf(key);
+        ScopedLock lock(s.mutex);
+        Slot* slot = s.map.find(key);
+        return slot ? slot->val : UNDEFINED;
     }
 
     virtual Value put(const Value& key, const Value& val) {
-        ScopedLock lock(mutex_);
-        return Map<I>::put(key, val);
+        Stripe& s = stripeOf(key);
+        ScopedLock lock(s.mutex);
+        Boolean inserted;
+        Slot* slot = s.map.insert(key, &inserted);
+        Value v = LIBJ_MOVE(slot->val);
+        slot->val = val;
+        return v;
+    }
+
+#ifdef LIBJ_USE_CXX11
+    virtual Value put(Value&& key, Value&& val) {
+        Stripe& s = stripeOf(key);
+        ScopedLock lock(s.mutex);
+        Boolean inserted;
+        Slot* slot = s.map.insert(std::move(key), &inserted);
+        Value v = std::move(slot->val);
+        slot->val = std::move(val);
+        return v;
     }
+#endif
 
     virtual Value remove(const Value& key) {
-        ScopedLock lock(mutex_);
-        return Map<I>::remove(key);
+        Stripe& s = stripeOf(key);
+        ScopedLock lock(s.mutex);
+        Slot* slot = s.map.find(key);
+        if (!slot) return UNDEFINED;
+
+        Value v = LIBJ_MOVE(slot->val);
+        s.map.erase(slot);
+        return v;
+    }
+
+    virtual Value putIfAbsent(const Value& key, const Value& val) {
+        Stripe& s = stripeOf(key);
+        ScopedLock lock(s.mutex);
+        Boolean inserted;
+        Slot* slot = s.map.insert(key, &inserted);
+        if (!inserted) return slot->val;
+
+        slot->val = val;
+        return UNDEFINED;
+    }
+
+    virtual Boolean replace(
+        const Value& key, const Value& oldVal, const Value& newVal) {
+        Stripe& s = stripeOf(key);
+        ScopedLock lock(s.mutex);
+        Slot* slot = s.map.find(key);
+        if (!slot || slot->val.compareTo(oldVal)) return false;
+
+        slot->val = newVal;
+        return true;
+    }
+
+    virtual Value computeIfAbsent(const Value& key, Function::Ptr func) {
+        if (!func) {
+            LIBJ_HANDLE_ERROR(Error::ILLEGAL_ARGUMENT);
+        }
+
+        Stripe& s = stripeOf(key);
+        ScopedLock lock(s.mutex);
+        Slot* slot = s.map.find(key);
+        if (slot) return slot->val;
+
+        Value v = func->call(key);
+        if (!v.isUndefined()) {
+            Boolean inserted;
+            s.map.insert(key, &inserted)->val = v;
+        }
+        return v;
+    }
+
+    virtual Value merge(
+        const Value& key, const Value& val, Function::Ptr func) {
+        if (!func) {
+            LIBJ_HANDLE_ERROR(Error::ILLEGAL_ARGUMENT);
+        }
+
+        Stripe& s = stripeOf(key);
+        ScopedLock lock(s.mutex);
+        Slot* slot = s.map.find(key);
+        if (!slot) {
+            Boolean inserted;
+            s.map.insert(key, &inserted)->val = val;
+            return val;
+        }
+
+        Value v = func->call(slot->val, val);
+        if (v.isUndefined()) {
+            s.map.erase(slot);
+        } else {
+            slot->val = v;
+        }
+        return v;
+    }
+
+    // the entries of map are copied before any stripe is locked,
+    // so that map is never accessed under the locks of this map.
+    // then all the stripes are locked in order to put them at once.
+    virtual void putAll(libj::Map::CPtr map) {
+        if (!map || &(*map) == this) return;
+
+        std::vector<Slot> slots;
+        slots.reserve(map->size());
+        typename EntryIteratorT::Ptr itr = map->entrySet()->iteratorTyped();
+        while (itr->hasNext()) {
+            typename EntryT::CPtr e = itr->nextTyped();
+            Slot slot = { e->getKey(), e->getValue() };
+            slots.push_back(slot);
+        }
+
+        StripesLock lock(stripes_);
+        Size n = slots.size();
+        for (Size i = 0; i < n; i++) {
+            Slot& slot = slots[i];
+            Stripe& s = stripeOf(slot.key);
+            Boolean inserted;
+            s.map.insert(LIBJ_MOVE(slot.key), &inserted)->val =
+                LIBJ_MOVE(slot.val);
+        }
     }
 
     virtual Set::CPtr keySet() const {
-        ScopedLock lock(mutex_);
-        return Map<I>::keySet();
+        return Set::CPtr(new KeySet(this));
+    }
+
+    virtual typename EntrySetT::CPtr entrySet() const {
+        return typename EntrySetT::CPtr(new EntrySet(this));
     }
 
     virtual void clear() {
-        ScopedLock lock(mutex_);
-        Map<I>::clear();
+        for (Size i = 0; i < NUM_STRIPES; i++) {
+            ScopedLock lock(stripes_[i].mutex);
+            stripes_[i].map.clear();
+        }
     }
 
     virtual Boolean isEmpty() const {
-        ScopedLock lock(mutex_);
-        return Map<I>::isEmpty();
+        for (Size i = 0; i < NUM_STRIPES; i++) {
+            ScopedLock lock(stripes_[i].mutex);
+            if (stripes_[i].map.size()) return false;
+        }
+        return true;
     }
 
     virtual String::CPtr toString() const {
-        ScopedLock lock(mutex_);
-        return Map<I>::toString();
+        libj::StringBuilder::Ptr sb = libj::StringBuilder::create();
+        sb->appendChar('{');
+        Boolean first = true;
+        SlotCursor cursor(this);
+        while (cursor.hasNext()) {
+            if (first) {
+                first = false;
+            } else {
+                sb->appendStr(LIBJ_U(", "));
+            }
+            sb->append(cursor.key());
+            sb->appendChar('=');
+            sb->append(cursor.value());
+            cursor.advance();
+        }
+        sb->appendChar('}');
+        return sb->build();
+    }
+
+ private:
+    static const Size STRIPE_BITS = 4;
+    static const Size NUM_STRIPES = 1 << STRIPE_BITS;
+
+    struct Stripe {
+        Mutex mutex;
+        Container map;
+
+        // keeps the locks of the stripes on separate cache lines
+        UByte padding[64];
+    };
+
+    // locks all the stripes, always in the same order
+    class StripesLock : private NonCopyable {
+     public:
+        StripesLock(Stripe* stripes) : stripes_(stripes) {
+            for (Size i = 0; i < NUM_STRIPES; i++) {
+                stripes_[i].mutex.lock();
+            }
+        }
+
+        ~StripesLock() {
+            for (Size i = NUM_STRIPES; i > 0; i--) {
+                stripes_[i - 1].mutex.unlock();
+            }
+        }
+
+     private:
+        Stripe* stripes_;
+    };
+
+    Stripe& stripeOf(const Value& key) const {
+        // Container finds the slots from the low bits
+        Size h = Container::hash(key);
+        return stripes_[h >> (sizeof(Size) * 8 - STRIPE_BITS)];
     }
 
+    // copies the slots of a stripe at a time
+    class SlotCursor {
+     public:
+        typedef ConcurrentMap Owner;
+
+        SlotCursor(const ConcurrentMap* self)
+            : self_(self)
+            , stripe_(0)
+            , pos_(0) {
+            fill();
+        }
+
+        Boolean hasNext() const {
+            return pos_ < slots_.size();
+        }
+
+        const Value& key() const {
+            return slots_[pos_].key;
+        }
+
+        const Value& value() const {
+            return slots_[pos_].val;
+        }
+
+        void advance() {
+            if (++pos_ == slots_.size()) fill();
+        }
+
+        static Boolean accepts(const Value& key) {
+            return true;
+        }
+
+     private:
+        void fill() {
+            while (stripe_ < NUM_STRIPES) {
+                slots_.clear();
+                pos_ = 0;
+
+                Stripe& s = self_->stripes_[stripe_++];
+                ScopedLock lock(s.mutex);
+                Size n = s.map.capacity();
+                for (Size i = s.map.next(0); i < n; i = s.map.next(i + 1)) {
+                    slots_.push_back(s.map.at(i));
+                }
+                if (!slots_.empty()) return;
+            }
+        }
+
+        const ConcurrentMap* self_;
+        Size stripe_;
+        Size pos_;
+        std::vector<Slot> slots_;
+    };
+
+    typedef MapKeySet<SlotCursor> KeySet;
+    typedef MapEntrySet<SlotCursor> EntrySet;
+
  private:
-    mutable Mutex mutex_;
+    mutable Stripe stripes_[NUM_STRIPES];
 };
 
 }  // namespace detail
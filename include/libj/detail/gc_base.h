@@ -94,18 +94,21 @@ class GCBase : virtual public gc {
 
 #else  // LIBJ_USE_BDWGC
 
-#if defined(LIBJ_USE_CXX11) && !defined(LIBJ_USE_CLANG)
-# include <memory>
-# define LIBJ_ENABLE_THIS(T) std::enable_shared_from_this<T>
+#ifdef LIBJ_USE_INTRUSIVE_PTR
+// the reference count is held by ObjectBase
 #else
-# include <boost/enable_shared_from_this.hpp>
-# define LIBJ_ENABLE_THIS(T) boost::enable_shared_from_this<T>
+# include <libj/detail/shared_ptr.h>
+# define LIBJ_ENABLE_THIS(T) libj::detail::EnableSharedFromThis<T>::Type
 #endif
 
 namespace libj {
 namespace detail {
 
+#ifdef LIBJ_USE_INTRUSIVE_PTR
+class GCBase {
+#else
 class GCBase : public LIBJ_ENABLE_THIS(GCBase) {
+#endif
  protected:
     GCBase() {
         LIBJ_DEBUG_OBJECT_COUNT_INC;
@@ -3,6 +3,8 @@
 #ifndef LIBJ_DETAIL_GENERIC_ARRAY_LIST_H_
 #define LIBJ_DETAIL_GENERIC_ARRAY_LIST_H_
 
+#include <libj/string_builder.h>
+#include <libj/symbol.h>
 #include <libj/detail/generic_list.h>
 
 #include <vector>
@@ -48,6 +50,30 @@ class GenericArrayList : public GenericList<I, T> {
         }
     }
 
+#ifdef LIBJ_USE_CXX11
+    virtual Boolean add(Value&& v) {
+        return add(v);
+    }
+
+    Boolean addTyped(T&& t) {
+        vec_.push_back(std::move(t));
+        return true;
+    }
+
+    virtual Boolean add(Size i, Value&& v) {
+        return add(i, v);
+    }
+
+    Boolean addTyped(Size i, T&& t) {
+        if (i > vec_.size()) {
+            return false;
+        } else {
+            vec_.insert(vec_.begin() + i, std::move(t));
+            return true;
+        }
+    }
+#endif
+
     virtual Boolean set(Size i, const Value& v) {
         T t;
         return convert<T>(v, &t) && setTyped(i, t);
@@ -161,6 +187,34 @@ class GenericArrayList : public GenericList<I, T> {
         return UNDEFINED;
     }
 
+    // not virtual unless I has join, which a JsArray does.
+    // the length of the result is computed first
+    // so that the builder allocates its buffer only once
+    String::CPtr join(String::CPtr separator = String::null()) const {
+        LIBJ_STATIC_SYMBOL_DEF(symComma, ",");
+
+        if (!separator) separator = symComma;
+
+        Size n = vec_.size();
+        std::vector<String::CPtr> strs(n);
+        Size len = n ? separator->length() * (n - 1) : 0;
+        for (Size i = 0; i < n; i++) {
+            Value v = vec_[i];
+            if (!v.isNull() && !v.isUndefined()) {
+                strs[i] = String::valueOf(v);
+                len += strs[i]->length();
+            }
+        }
+
+        libj::StringBuilder::Ptr sb = libj::StringBuilder::create();
+        sb->reserve(len);
+        for (Size i = 0; i < n; i++) {
+            if (i) sb->appendStr(separator);
+            if (strs[i]) sb->appendStr(strs[i]);
+        }
+        return sb->build();
+    }
+
  private:
     class TypedObverseIterator : public TypedIterator<T> {
         friend class GenericArrayList;
@@ -124,7 +124,7 @@ class GenericCollection : public I {
             sb->append(v);
         }
         sb->appendChar(']');
-        return sb->toString();
+        return sb->build();
     }
 };
 
@@ -27,20 +27,7 @@ class GenericJsArray : public GenericArrayList<I, T> {
     }
 
     virtual String::CPtr toString() const {
-        libj::StringBuilder::Ptr sb = libj::StringBuilder::create();
-        Iterator::Ptr itr = this->iterator();
-        Boolean first = true;
-        while (itr->hasNext()) {
-            Value v = itr->next();
-            if (first) {
-                first = false;
-            } else {
-                sb->appendChar(',');
-            }
-            if (!v.isNull() && !v.isUndefined())
-                sb->append(v);
-        }
-        return sb->toString();
+        return this->join();
     }
 
  public:
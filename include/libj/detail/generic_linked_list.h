@@ -50,6 +50,32 @@ class GenericLinkedList : public GenericList<I, T> {
         }
     }
 
+#ifdef LIBJ_USE_CXX11
+    virtual Boolean add(Value&& v) {
+        return add(v);
+    }
+
+    Boolean addTyped(T&& t) {
+        list_.push_back(std::move(t));
+        return true;
+    }
+
+    virtual Boolean add(Size i, Value&& v) {
+        return add(i, v);
+    }
+
+    Boolean addTyped(Size i, T&& t) {
+        if (i > list_.size()) {
+            return false;
+        } else {
+            Itr pos = list_.begin();
+            for (; i; i--) ++pos;
+            list_.insert(pos, std::move(t));
+            return true;
+        }
+    }
+#endif
+
     virtual Boolean offer(const Value& v) {
         T t;
         return convert(v, &t, false) && addTyped(t);
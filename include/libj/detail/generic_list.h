@@ -47,6 +47,12 @@ class GenericList : public GenericCollection<I, T> {
 
     virtual typename TypedIterator<T>::Ptr reverseIteratorTyped() const = 0;
 
+#ifdef LIBJ_USE_CXX11
+    virtual Boolean add(Value&& v) = 0;
+
+    virtual Boolean add(Size i, Value&& v) = 0;
+#endif
+
  public:
     virtual Size length() const {
         return size();
@@ -82,6 +88,13 @@ class GenericList : public GenericCollection<I, T> {
         return size();
     }
 
+#ifdef LIBJ_USE_CXX11
+    virtual Size push(Value&& val) {
+        add(std::move(val));
+        return size();
+    }
+#endif
+
     virtual Size pushTyped(const T& t) {
         addTyped(t);
         return size();
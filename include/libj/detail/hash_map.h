@@ -0,0 +1,158 @@
+// Copyright (c) 2013 Plenluno All rights reserved.
+
+#ifndef LIBJ_DETAIL_HASH_MAP_H_
+#define LIBJ_DETAIL_HASH_MAP_H_
+
+#include <libj/typed_set.h>
+#include <libj/string_builder.h>
+#include <libj/detail/hash_table.h>
+#include <libj/detail/map_view.h>
+
+namespace libj {
+namespace detail {
+
+// the keys are found by Value::hashCode and Value::equals,
+// and iterated in no particular order
+template<typename I>
+class HashMap : public I {
+ private:
+    struct Slot {
+        Value key;
+        Value val;
+    };
+
+    typedef HashTable<Slot> Container;
+
+    typedef typename I::Entry EntryT;
+    typedef TypedSet<typename EntryT::CPtr> EntrySetT;
+    typedef TypedIterator<typename EntryT::CPtr> EntryIteratorT;
+
+ public:
+    virtual Size size() const {
+        return map_.size();
+    }
+
+    virtual Boolean containsKey(const Value& key) const {
+        return !!map_.find(key);
+    }
+
+    virtual Boolean containsValue(const Value& val) const {
+        Size n = map_.capacity();
+        for (Size i = map_.next(0); i < n; i = map_.next(i + 1)) {
+            if (!map_.at(i).val.compareTo(val))
+                return true;
+        }
+        return false;
+    }
+
+    virtual Value get(const Value& key) const {
+        Slot* s = map_.find(key);
+        return s ? s->val : UNDEFINED;
+    }
+
+    virtual Value put(const Value& key, const Value& val) {
+        Boolean inserted;
+        Slot* s = map_.insert(key, &inserted);
+        Value v = LIBJ_MOVE(s->val);
+        s->val = val;
+        return v;
+    }
+
+#ifdef LIBJ_USE_CXX11
+    virtual Value put(Value&& key, Value&& val) {
+        Boolean inserted;
+        Slot* s = map_.insert(std::move(key), &inserted);
+        Value v = std::move(s->val);
+        s->val = std::move(val);
+        return v;
+    }
+#endif
+
+    virtual Value remove(const Value& key) {
+        Slot* s = map_.find(key);
+        if (!s) return UNDEFINED;
+
+        Value v = LIBJ_MOVE(s->val);
+        map_.erase(s);
+        return v;
+    }
+
+    virtual void putAll(libj::Map::CPtr map) {
+        if (!map || &(*map) == this) return;
+
+        map_.reserve(map_.size() + map->size());
+        typename EntryIteratorT::Ptr itr = map->entrySet()->iteratorTyped();
+        while (itr->hasNext()) {
+            typename EntryT::CPtr e = itr->nextTyped();
+            Boolean inserted;
+            map_.insert(e->getKey(), &inserted)->val = e->getValue();
+        }
+    }
+
+    virtual Set::CPtr keySet() const {
+        return Set::CPtr(new KeySet(this));
+    }
+
+    virtual typename EntrySetT::CPtr entrySet() const {
+        return typename EntrySetT::CPtr(new EntrySet(this));
+    }
+
+    virtual void clear() {
+        map_.clear();
+    }
+
+    virtual Boolean isEmpty() const {
+        return map_.size() == 0;
+    }
+
+    virtual String::CPtr toString() const {
+        libj::StringBuilder::Ptr sb = libj::StringBuilder::create();
+        sb->appendChar('{');
+        Boolean first = true;
+        Size n = map_.capacity();
+        for (Size i = map_.next(0); i < n; i = map_.next(i + 1)) {
+            if (first) {
+                first = false;
+            } else {
+                sb->appendStr(LIBJ_U(", "));
+            }
+            sb->append(map_.at(i).key);
+            sb->appendChar('=');
+            sb->append(map_.at(i).val);
+        }
+        sb->appendChar('}');
+        return sb->build();
+    }
+
+ private:
+    class SlotCursor : public Container::Cursor {
+     public:
+        typedef HashMap Owner;
+
+        SlotCursor(const HashMap* self)
+            : Container::Cursor(&self->map_) {}
+
+        const Value& key() const {
+            return this->get().key;
+        }
+
+        const Value& value() const {
+            return this->get().val;
+        }
+
+        static Boolean accepts(const Value& key) {
+            return true;
+        }
+    };
+
+    typedef MapKeySet<SlotCursor> KeySet;
+    typedef MapEntrySet<SlotCursor> EntrySet;
+
+ private:
+    Container map_;
+};
+
+}  // namespace detail
+}  // namespace libj
+
+#endif  // LIBJ_DETAIL_HASH_MAP_H_
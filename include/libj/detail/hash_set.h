@@ -0,0 +1,111 @@
+// Copyright (c) 2013 Plenluno All rights reserved.
+
+#ifndef LIBJ_DETAIL_HASH_SET_H_
+#define LIBJ_DETAIL_HASH_SET_H_
+
+#include <libj/detail/generic_collection.h>
+#include <libj/detail/hash_table.h>
+
+namespace libj {
+namespace detail {
+
+// the values are found by Value::hashCode and Value::equals,
+// and iterated in no particular order
+template<typename I>
+class HashSet : public GenericCollection<I, Value> {
+ private:
+    struct Slot {
+        Value key;
+    };
+
+    typedef HashTable<Slot> Container;
+
+ public:
+    virtual Size size() const {
+        return set_.size();
+    }
+
+    virtual Boolean add(const Value& v) {
+        return addTyped(v);
+    }
+
+    virtual Boolean addTyped(const Value& v) {
+        Boolean inserted;
+        set_.insert(v, &inserted);
+        return inserted;
+    }
+
+    virtual Boolean remove(const Value& v) {
+        return removeTyped(v);
+    }
+
+    virtual Boolean removeTyped(const Value& v) {
+        return set_.erase(v);
+    }
+
+    virtual Boolean contains(const Value& v) const {
+        return !!set_.find(v);
+    }
+
+    virtual void clear() {
+        set_.clear();
+    }
+
+    virtual Iterator::Ptr iterator() const {
+        return Iterator::Ptr(new TypedSetIterator(&set_));
+    }
+
+    virtual typename TypedIterator<Value>::Ptr iteratorTyped() const {
+        return typename TypedIterator<Value>::Ptr(
+            new TypedSetIterator(&set_));
+    }
+
+ private:
+    class TypedSetIterator : public TypedIterator<Value> {
+        friend class HashSet;
+
+     public:
+        virtual Boolean hasNext() const {
+            return cursor_.hasNext();
+        }
+
+        virtual Value next() {
+            if (!hasNext()) {
+                LIBJ_HANDLE_ERROR(Error::NO_SUCH_ELEMENT);
+            } else {
+                return nextValue();
+            }
+        }
+
+        virtual Value nextTyped() {
+            if (!hasNext()) {
+                LIBJ_THROW(Error::NO_SUCH_ELEMENT);
+            }
+
+            return nextValue();
+        }
+
+        virtual String::CPtr toString() const {
+            return String::create();
+        }
+
+     private:
+        typename Container::Cursor cursor_;
+
+        TypedSetIterator(const Container* set) : cursor_(set) {}
+
+        Value nextValue() {
+            Value v = cursor_.get().key;
+            cursor_.advance();
+            return v;
+        }
+    };
+
+ private:
+    Container set_;
+};
+
+}  // namespace detail
+}  // namespace libj
+
+#endif  // LIBJ_DETAIL_HASH_SET_H_
@@ -0,0 +1,238 @@
+// Copyright (c) 2013 Plenluno All rights reserved.
+
+#ifndef LIBJ_DETAIL_HASH_TABLE_H_
+#define LIBJ_DETAIL_HASH_TABLE_H_
+
+#include <libj/value.h>
+#include <libj/detail/noncopyable.h>
+
+#include <assert.h>
+
+namespace libj {
+namespace detail {
+
+// an open addressing table of entries E, which have a Value key,
+// probed linearly by the hash codes of the keys.
+// the hash codes are stored apart from the entries so that a probe
+// reads the entries only when their hash codes match.
+// an erased entry is filled by shifting the following ones back,
+// so that there are no tombstones.
+template<typename E>
+class HashTable : private NonCopyable {
+ public:
+    HashTable()
+        : hashes_(NULL)
+        , entries_(NULL)
+        , size_(0)
+        , mask_(0) {}
+
+    ~HashTable() {
+        delete[] hashes_;
+        delete[] entries_;
+    }
+
+    Size size() const {
+        return size_;
+    }
+
+    // returns the entry of key, or NULL if there is none
+    E* find(const Value& key) const {
+        if (!size_) return NULL;
+
+        Size h = hash(key);
+        for (Size i = h & mask_; hashes_[i]; i = (i + 1) & mask_) {
+            if (hashes_[i] == h && entries_[i].key.equals(key)) {
+                return &entries_[i];
+            }
+        }
+        return NULL;
+    }
+
+    // returns the entry of key, which is added if there is none
+    E* insert(const Value& key, Boolean* inserted) {
+        Size i = place(key, inserted);
+        E* e = &entries_[i];
+        if (*inserted) e->key = key;
+        return e;
+    }
+
+#ifdef LIBJ_USE_CXX11
+    E* insert(Value&& key, Boolean* inserted) {
+        Size i = place(key, inserted);
+        E* e = &entries_[i];
+        if (*inserted) e->key = std::move(key);
+        return e;
+    }
+#endif
+
+    Boolean erase(const Value& key) {
+        E* e = find(key);
+        if (!e) return false;
+
+        erase(e);
+        return true;
+    }
+
+    // e is returned by find or insert
+    void erase(E* e) {
+        Size i = e - entries_;
+        Size j = i;
+        for (;;) {
+            j = (j + 1) & mask_;
+            if (!hashes_[j]) break;
+
+            // the entry at j stays if it is found from its home before i
+            Size home = hashes_[j] & mask_;
+            if (i <= j ? (i < home && home <= j) : (i < home || home <= j)) {
+                continue;
+            }
+
+            hashes_[i] = hashes_[j];
+            entries_[i] = LIBJ_MOVE(entries_[j]);
+            i = j;
+        }
+        hashes_[i] = 0;
+        entries_[i] = E();
+        size_--;
+    }
+
+    // makes room for n entries without growing
+    void reserve(Size n) {
+        Size m = capacity();
+        if (n * 4 <= m * 3) return;
+
+        if (!m) m = MIN_CAPACITY;
+        while (n * 4 > m * 3) m *= 2;
+        rehash(m);
+    }
+
+    void clear() {
+        delete[] hashes_;
+        delete[] entries_;
+        hashes_ = NULL;
+        entries_ = NULL;
+        size_ = 0;
+        mask_ = 0;
+    }
+
+    // the slots are indexed from 0 to capacity() - 1
+
+    Size capacity() const {
+        return hashes_ ? mask_ + 1 : 0;
+    }
+
+    // returns the first slot in use at or after i, or capacity()
+    Size next(Size i) const {
+        Size n = capacity();
+        while (i < n && !hashes_[i]) i++;
+        return i;
+    }
+
+    const E& at(Size i) const {
+        assert(i < capacity() && hashes_[i]);
+        return entries_[i];
+    }
+
+    // walks the slots in use. it reads the table from the slot after
+    // the previous one on each call, so that it never refers to
+    // the storage released by a rehash.
+    class Cursor {
+     public:
+        Cursor(const HashTable* table)
+            : table_(table)
+            , pos_(table->next(0)) {}
+
+        Boolean hasNext() const {
+            return pos_ < table_->capacity();
+        }
+
+        const E& get() const {
+            return table_->at(pos_);
+        }
+
+        void advance() {
+            pos_ = table_->next(pos_ + 1);
+        }
+
+     private:
+        const HashTable* table_;
+        Size pos_;
+    };
+
+    // the slot of key is found from the low bits of its hash,
+    // which is never 0, the mark of an empty slot
+    static Size hash(const Value& key) {
+        ULong h = key.hashCode();
+        h ^= h >> 33;
+        h *= 0xff51afd7ed558ccdULL;
+        h ^= h >> 33;
+        h *= 0xc4ceb9fe1a85ec53ULL;
+        h ^= h >> 33;
+        Size s = static_cast<Size>(h);
+        return s ? s : 1;
+    }
+
+ private:
+    static const Size MIN_CAPACITY = 8;
+
+    // returns the slot of key, which is taken if there is none
+    Size place(const Value& key, Boolean* inserted) {
+        Size h = hash(key);
+        Size i = h & mask_;
+        if (hashes_) {
+            for (; hashes_[i]; i = (i + 1) & mask_) {
+                if (hashes_[i] == h && entries_[i].key.equals(key)) {
+                    *inserted = false;
+                    return i;
+                }
+            }
+        }
+
+        // keeps the load factor at most 3/4
+        if (!hashes_ || (size_ + 1) * 4 > (mask_ + 1) * 3) {
+            grow();
+            for (i = h & mask_; hashes_[i]; i = (i + 1) & mask_) {}
+        }
+
+        hashes_[i] = h;
+        size_++;
+        *inserted = true;
+        return i;
+    }
+
+    void grow() {
+        Size n = capacity();
+        rehash(n ? n * 2 : MIN_CAPACITY);
+    }
+
+    void rehash(Size m) {
+        Size* hashes = hashes_;
+        E* entries = entries_;
+        Size n = capacity();
+
+        hashes_ = new Size[m]();
+        entries_ = new E[m];
+        mask_ = m - 1;
+        for (Size i = 0; i < n; i++) {
+            Size h = hashes[i];
+            if (!h) continue;
+
+            Size j = h & mask_;
+            while (hashes_[j]) j = (j + 1) & mask_;
+            hashes_[j] = h;
+            entries_[j] = LIBJ_MOVE(entries[i]);
+        }
+        delete[] hashes;
+        delete[] entries;
+    }
+
+    Size* hashes_;
+    E* entries_;
+    Size size_;
+    Size mask_;
+};
+
+}  // namespace detail
+}  // namespace libj
+
+#endif  // LIBJ_DETAIL_HASH_TABLE_H_
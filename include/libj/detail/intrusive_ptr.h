@@ -0,0 +1,85 @@
+// Copyright (c) 2013 Plenluno All rights reserved.
+
+#ifndef LIBJ_DETAIL_INTRUSIVE_PTR_H_
+#define LIBJ_DETAIL_INTRUSIVE_PTR_H_
+
+#include <libj/typedef.h>
+
+#include <boost/intrusive_ptr.hpp>
+
+#ifdef LIBJ_USE_THREAD
+# include <libj/detail/atomic.h>
+#endif
+
+namespace libj {
+namespace detail {
+
+template<typename T>
+struct IntrusivePtr {
+    typedef boost::intrusive_ptr<T> Type;
+};
+
+// the reference count embedded in every object.
+// objects are deleted through the virtual destructor
+// when the last pointer to them is released.
+class RefCount {
+ public:
+    Long useCount() const {
+        return static_cast<Long>(count_);
+    }
+
+ protected:
+    RefCount() : count_(0) {}
+
+    virtual ~RefCount() {}
+
+ private:
+#ifdef LIBJ_USE_THREAD
+    mutable LIBJ_DETAIL_ATOMIC(Size) count_;
+
+    void addRef() const {
+        count_.fetch_add(1, LIBJ_DETAIL_MEMORY_ORDER(relaxed));
+    }
+
+    Boolean release() const {
+        return count_.fetch_sub(1, LIBJ_DETAIL_MEMORY_ORDER(acq_rel)) == 1;
+    }
+#else
+    mutable Size count_;
+
+    void addRef() const {
+        ++count_;
+    }
+
+    Boolean release() const {
+        return !--count_;
+    }
+#endif
+
+    friend void intrusive_ptr_add_ref(const RefCount* p);
+    friend void intrusive_ptr_release(const RefCount* p);
+};
+
+inline void intrusive_ptr_add_ref(const RefCount* p) {
+    p->addRef();
+}
+
+inline void intrusive_ptr_release(const RefCount* p) {
+    if (p->release()) delete p;
+}
+
+template<typename T, typename U>
+inline boost::intrusive_ptr<T> staticPointerCast(U* p) {
+    return boost::intrusive_ptr<T>(static_cast<T*>(p));
+}
+
+template<typename T, typename U>
+inline boost::intrusive_ptr<T> staticPointerCast(
+    const boost::intrusive_ptr<U>& p) {
+    return boost::intrusive_ptr<T>(static_cast<T*>(p.get()));
+}
+
+}  // namespace detail
+}  // namespace libj
+
+#endif  // LIBJ_DETAIL_INTRUSIVE_PTR_H_
@@ -1,31 +1,132 @@
-// Copyright (c) 2012 Plenluno All rights reserved.
+// Copyright (c) 2012-2013 Plenluno All rights reserved.
 
 #ifndef LIBJ_DETAIL_JS_OBJECT_H_
 #define LIBJ_DETAIL_JS_OBJECT_H_
 
 #include <libj/symbol.h>
-#include <libj/detail/map.h>
+#include <libj/typed_set.h>
+#include <libj/detail/map_view.h>
+#include <libj/detail/shape.h>
+
+#include <vector>
 
 namespace libj {
 namespace detail {
 
+// the properties are iterated in insertion order.
+// the keys are kept in a Shape shared by the objects with the same keys,
+// and the values in the slots indexed by the shape.
+// the slot at a hole of the shape is UNDEFINED.
 template<typename I>
-class JsObject : public Map<I> {
+class JsObject : public I {
+ private:
+    typedef std::vector<Value> Slots;
+
+    typedef typename I::Entry EntryT;
+    typedef TypedSet<typename EntryT::CPtr> EntrySetT;
+    typedef TypedIterator<typename EntryT::CPtr> EntryIteratorT;
+
  public:
+    JsObject() : shape_(Shape::root()) {}
+
+    virtual ~JsObject() {
+        shape_->release();
+    }
+
+    virtual Size size() const {
+        return shape_->size();
+    }
+
     virtual Boolean containsKey(const Value& key) const {
-        return Map<I>::containsKey(String::valueOf(key));
+        return shape_->indexOf(String::valueOf(key)) != NO_POS;
+    }
+
+    virtual Boolean containsValue(const Value& val) const {
+        Size n = slots_.size();
+        for (Size i = nextIndex(0); i < n; i = nextIndex(i + 1)) {
+            if (!slots_[i].compareTo(val))
+                return true;
+        }
+        return false;
     }
 
     virtual Value get(const Value& key) const {
-        return Map<I>::get(String::valueOf(key));
+        Size i = shape_->indexOf(String::valueOf(key));
+        return i != NO_POS ? slots_[i] : UNDEFINED;
     }
 
     virtual Value put(const Value& key, const Value& val) {
-        return Map<I>::put(String::valueOf(key), val);
+        String::CPtr name = String::valueOf(key);
+        Size i = shape_->indexOf(name);
+        if (i != NO_POS) {
+            Value v = LIBJ_MOVE(slots_[i]);
+            slots_[i] = val;
+            return v;
+        } else {
+            shape_ = shape_->add(name);
+            slots_.push_back(val);
+            return UNDEFINED;
+        }
+    }
+
+#ifdef LIBJ_USE_CXX11
+    virtual Value put(Value&& key, Value&& val) {
+        String::CPtr name = String::valueOf(key);
+        Size i = shape_->indexOf(name);
+        if (i != NO_POS) {
+            Value v = std::move(slots_[i]);
+            slots_[i] = std::move(val);
+            return v;
+        } else {
+            shape_ = shape_->add(name);
+            slots_.push_back(std::move(val));
+            return UNDEFINED;
+        }
     }
+#endif
 
     virtual Value remove(const Value& key) {
-        return Map<I>::remove(String::valueOf(key));
+        Size i = shape_->indexOf(String::valueOf(key));
+        if (i == NO_POS) return UNDEFINED;
+
+        Value v = LIBJ_MOVE(slots_[i]);
+        shape_ = shape_->remove(i);
+        if (shape_->length() < slots_.size()) {
+            slots_.pop_back();
+        } else {
+            slots_[i] = UNDEFINED;
+            if (shape_->isSparse()) compact();
+        }
+        return v;
+    }
+
+    virtual void putAll(libj::Map::CPtr map) {
+        if (!map || &(*map) == this) return;
+
+        slots_.reserve(slots_.size() + map->size());
+        typename EntryIteratorT::Ptr itr = map->entrySet()->iteratorTyped();
+        while (itr->hasNext()) {
+            typename EntryT::CPtr e = itr->nextTyped();
+            put(e->getKey(), e->getValue());
+        }
+    }
+
+    virtual Set::CPtr keySet() const {
+        return Set::CPtr(new KeySet(this));
+    }
+
+    virtual typename EntrySetT::CPtr entrySet() const {
+        return typename EntrySetT::CPtr(new EntrySet(this));
+    }
+
+    virtual void clear() {
+        shape_->release();
+        shape_ = Shape::root();
+        slots_.clear();
+    }
+
+    virtual Boolean isEmpty() const {
+        return !size();
     }
 
     virtual String::CPtr toString() const {
@@ -49,6 +150,98 @@ class JsObject : public Map<I> {
     virtual Value deleteProperty(const Value& name) {
         return remove(name);
     }
+
+    virtual Boolean hasProperty(const JsPropertyKey& key) const {
+        return indexOf(key) != NO_POS;
+    }
+
+    virtual Value getProperty(const JsPropertyKey& key) const {
+        Size i = indexOf(key);
+        return i != NO_POS ? slots_[i] : UNDEFINED;
+    }
+
+    virtual Value setProperty(const JsPropertyKey& key, const Value& val) {
+        Size i = indexOf(key);
+        if (i != NO_POS) {
+            Value v = LIBJ_MOVE(slots_[i]);
+            slots_[i] = val;
+            return v;
+        } else {
+            return put(key.name(), val);
+        }
+    }
+
+ private:
+    class SlotCursor {
+     public:
+        typedef JsObject Owner;
+
+        SlotCursor(const JsObject* self)
+            : self_(self)
+            , pos_(self->nextIndex(0)) {}
+
+        Boolean hasNext() const {
+            return pos_ < self_->slots_.size();
+        }
+
+        const Value& key() const {
+            return self_->shape_->keyAt(pos_);
+        }
+
+        const Value& value() const {
+            return self_->slots_[pos_];
+        }
+
+        void advance() {
+            pos_ = self_->nextIndex(pos_ + 1);
+        }
+
+        // the keys are strings, into which containsKey converts any value
+        static Boolean accepts(const Value& key) {
+            return key.is<String>();
+        }
+
+     private:
+        const JsObject* self_;
+        Size pos_;
+    };
+
+    typedef MapKeySet<SlotCursor> KeySet;
+    typedef MapEntrySet<SlotCursor> EntrySet;
+
+ private:
+    // returns the first index of a key at or after i, or slots_.size()
+    Size nextIndex(Size i) const {
+        Size n = slots_.size();
+        while (i < n && shape_->keyAt(i).isUndefined()) i++;
+        return i;
+    }
+
+    // removes the slots at the holes of the shape, and then the holes
+    void compact() {
+        Size n = 0;
+        for (Size i = nextIndex(0); i < slots_.size(); i = nextIndex(i + 1)) {
+            if (n != i) slots_[n] = LIBJ_MOVE(slots_[i]);
+            n++;
+        }
+        slots_.resize(n);
+        shape_->compact();
+    }
+
+    Size indexOf(const JsPropertyKey& key) const {
+        Size i = shape_->cachedIndex(key.cache());
+        if (i == NO_POS) {
+            i = shape_->indexOf(key.name());
+            if (i != NO_POS && shape_->isShared()) {
+                key.setCache(shape_->cacheEntry(i));
+            }
+        }
+        return i;
+    }
+
+ private:
+    Shape* shape_;
+    Slots slots_;
 };
 
 }  // namespace detail
@@ -61,6 +61,8 @@ class JsRegExp : public JsObject<I> {
         return to<Size>(this->get(symLastIndex));
     }
 
+    // matches from lastIndex of str if global, without copying the rest.
+    // index of the result is the position in str, which is its input.
     virtual JsArray::Ptr exec(String::CPtr str) {
         LIBJ_STATIC_SYMBOL_DEF(symIndex, "index");
         LIBJ_STATIC_SYMBOL_DEF(symInput, "input");
@@ -71,28 +73,24 @@ class JsRegExp : public JsObject<I> {
         Boolean global = this->global();
         if (global) {
             lastIndex = this->lastIndex();
-            if (lastIndex > str->length()) {
-                return execFail();
-            } else {
-                str = str->substring(lastIndex);
-            }
+            if (lastIndex > str->length()) return execFail();
         }
 
         int len;
         std::vector<int> captures;
         Boolean success;
         if (glue::RegExp::encoding() == encoding()) {
-            len = str->length();
-            success = re_->execute(str->data(), len, 0, captures);
+            len = str->length() - lastIndex;
+            success = re_->execute(str->data() + lastIndex, len, 0, captures);
         } else {
-            std::string s = toStdString(str);
+            std::string s = toStdString(str->substring(lastIndex));
             len = getLength(s);
             success = re_->execute(s.data(), len, 0, captures);
         }
 
         if (!success) return execFail();
 
-        if (global) setLastIndex(lastIndex + (captures[1] - captures[0]));
+        if (global) setLastIndex(lastIndex + captures[1]);
 
         JsArray::Ptr res = JsArray::create();
         Size size = captures.size();
@@ -102,13 +100,15 @@ class JsRegExp : public JsObject<I> {
                 captures[i+1] >= 0 &&
                 captures[i] <= captures[i+1] &&
                 captures[i+1] <= len) {
-                res->add(str->substring(captures[i], captures[i+1]));
+                res->add(str->substring(
+                    lastIndex + captures[i],
+                    lastIndex + captures[i+1]));
             } else {
                 res->add(UNDEFINED);
             }
         }
         res->setProperty(symInput, str);
-        res->setProperty(symIndex, captures[0]);
+        res->setProperty(symIndex, static_cast<Int>(lastIndex) + captures[0]);
         return res;
     }
 
@@ -116,6 +116,63 @@ class JsRegExp : public JsObject<I> {
         return !!exec(str);
     }
 
+    // finds each match from the end of the last one on the whole input,
+    // where an empty match at the end of the last one is skipped
+    virtual JsArray::Ptr split(String::CPtr str, Size limit) const {
+        if (!str) return JsArray::null();
+
+        JsArray::Ptr res = JsArray::create();
+        if (!limit) return res;
+
+        int len;
+        const void* chars;
+        std::string s;
+        if (glue::RegExp::encoding() == encoding()) {
+            len = str->length();
+            chars = str->data();
+        } else {
+            s = toStdString(str);
+            len = getLength(s);
+            chars = s.data();
+        }
+
+        std::vector<int> captures;
+        if (!len) {
+            if (!re_->execute(chars, len, 0, captures)) res->add(str);
+            return res;
+        }
+
+        int prev = 0;
+        int from = 0;
+        while (from < len && re_->execute(chars, len, from, captures)) {
+            int begin = captures[0];
+            int end = captures[1];
+            if (begin >= len) break;
+
+            if (end == prev) {
+                from = begin + 1;
+                continue;
+            }
+
+            res->add(str->substring(prev, begin));
+            if (res->size() == limit) return res;
+
+            Size size = captures.size();
+            for (Size i = 2; i < size; i += 2) {
+                if (captures[i] >= 0 && captures[i] <= captures[i+1]) {
+                    res->add(str->substring(captures[i], captures[i+1]));
+                } else {
+                    res->add(UNDEFINED);
+                }
+                if (res->size() == limit) return res;
+            }
+            prev = end;
+            from = end;
+        }
+        res->add(str->substring(prev));
+        return res;
+    }
+
  private:
     static glue::RegExp::Encoding encoding() {
 #ifdef LIBJ_USE_UTF32
@@ -19,6 +19,16 @@ class LinkedList : public GenericLinkedList<I, Value> {
         return GenericLinkedList<I, Value>::addTyped(i, v);
     }
 
+#ifdef LIBJ_USE_CXX11
+    virtual Boolean add(Value&& v) {
+        return GenericLinkedList<I, Value>::addTyped(std::move(v));
+    }
+
+    virtual Boolean add(Size i, Value&& v) {
+        return GenericLinkedList<I, Value>::addTyped(i, std::move(v));
+    }
+#endif
+
     virtual Boolean set(Size i, const Value& v) {
         return GenericLinkedList<I, Value>::setTyped(i, v);
     }
@@ -5,6 +5,7 @@
 
 #include <libj/typed_set.h>
 #include <libj/string_builder.h>
+#include <libj/detail/map_view.h>
 
 #include <map>
 
@@ -15,6 +16,7 @@ template<typename I>
 class Map : public I {
  private:
     typedef std::map<Value, Value> Container;
+    typedef typename Container::iterator Itr;
     typedef typename Container::const_iterator CItr;
 
     typedef typename I::Entry EntryT;
@@ -50,26 +52,68 @@ class Map : public I {
     }
 
     virtual Value put(const Value& key, const Value& val) {
-        if (map_) {
-            Value v = _get(key);
-            (*map_)[key] = val;
+        if (!map_) map_ = new Container();
+
+        Itr itr = map_->lower_bound(key);
+        if (itr != map_->end() && !map_->key_comp()(key, itr->first)) {
+            Value v = LIBJ_MOVE(itr->second);
+            itr->second = val;
             return v;
         } else {
-            map_ = new Container();
-            (*map_)[key] = val;
+            map_->insert(itr, std::make_pair(key, val));
             return UNDEFINED;
         }
     }
 
-    virtual Value remove(const Value& key) {
-        if (map_) {
-            Value v = _get(key);
-            map_->erase(key);
+#ifdef LIBJ_USE_CXX11
+    virtual Value put(Value&& key, Value&& val) {
+        if (!map_) map_ = new Container();
+
+        Itr itr = map_->lower_bound(key);
+        if (itr != map_->end() && !map_->key_comp()(key, itr->first)) {
+            Value v = std::move(itr->second);
+            itr->second = std::move(val);
             return v;
         } else {
+            map_->insert(itr, std::make_pair(std::move(key), std::move(val)));
             return UNDEFINED;
         }
     }
+#endif
+
+    virtual Value remove(const Value& key) {
+        if (!map_) return UNDEFINED;
+
+        Itr itr = map_->find(key);
+        if (itr == map_->end()) return UNDEFINED;
+
+        Value v = LIBJ_MOVE(itr->second);
+        map_->erase(itr);
+        return v;
+    }
+
+    // each entry is inserted right after the previous one if it fits there,
+    // so that the entries in ascending order are loaded in linear time
+    virtual void putAll(libj::Map::CPtr map) {
+        if (!map || &(*map) == this) return;
+        if (!map_) map_ = new Container();
+
+        Itr hint = map_->end();
+        typename EntryIteratorT::Ptr itr = map->entrySet()->iteratorTyped();
+        while (itr->hasNext()) {
+            typename EntryT::CPtr e = itr->nextTyped();
+            Value key = e->getKey();
+            if (!fits(hint, key)) hint = map_->lower_bound(key);
+
+            if (hint != map_->end() && !map_->key_comp()(key, hint->first)) {
+                hint->second = e->getValue();
+                ++hint;
+            } else {
+                hint = map_->insert(hint, std::make_pair(key, e->getValue()));
+                ++hint;
+            }
+        }
+    }
 
     virtual Set::CPtr keySet() const {
         return Set::CPtr(new KeySet(this));
@@ -107,217 +151,61 @@ class Map : public I {
             sb->append(e->getValue());
         }
         sb->appendChar('}');
-        return sb->toString();
+        return sb->build();
     }
 
  private:
-    class KeySet : public GenericCollection<Set, Value> {
-     public:
-        KeySet(const typename detail::Map<I>* self) : self_(self) {}
-
-        virtual Size size() const {
-            return self_->size();
-        }
-
-        virtual Iterator::Ptr iterator() const {
-            return Iterator::Ptr(new KeyIterator(self_->map_));
-        }
-
+    class SlotCursor {
      public:
-        class KeyIterator : public Iterator {
-            friend class KeySet;
-
-         public:
-            virtual Boolean hasNext() const {
-                return map_ && pos_ != end_;
-            }
-
-            virtual Value next() {
-                if (!map_ || pos_ == end_) {
-                    LIBJ_HANDLE_ERROR(Error::NO_SUCH_ELEMENT);
-                } else {
-                    Value key = pos_->first;
-                    ++pos_;
-                    return key;
-                }
-            }
+        typedef Map Owner;
 
-            virtual String::CPtr toString() const {
-                return String::create();
-            }
-
-         private:
-            const typename Map<I>::Container* map_;
-            typename Map<I>::CItr pos_;
-            typename Map<I>::CItr end_;
-
-            KeyIterator(const typename Map<I>::Container* map)
-                : map_(map)
-                , pos_(map ? map->begin() : typename Map<I>::CItr())
-                , end_(map ? map->end() : typename Map<I>::CItr()) {}
-        };
-
-     public:
-        virtual void clear() {
-            LIBJ_THROW(Error::UNSUPPORTED_OPERATION);
-        }
+        SlotCursor(const Map* self)
+            : map_(self->map_)
+            , pos_(map_ ? map_->begin() : CItr())
+            , end_(map_ ? map_->end() : CItr()) {}
 
-        virtual Boolean add(const Value& v) {
-            LIBJ_THROW(Error::UNSUPPORTED_OPERATION);
-            return false;
+        Boolean hasNext() const {
+            return map_ && pos_ != end_;
         }
 
-        virtual Boolean remove(const Value& v) {
-            LIBJ_THROW(Error::UNSUPPORTED_OPERATION);
-            return false;
+        const Value& key() const {
+            return pos_->first;
         }
 
-        virtual Boolean addTyped(const Value& v) {
-            LIBJ_THROW(Error::UNSUPPORTED_OPERATION);
-            return false;
+        const Value& value() const {
+            return pos_->second;
         }
 
-        virtual Boolean removeTyped(const Value& v) {
-            LIBJ_THROW(Error::UNSUPPORTED_OPERATION);
-            return false;
+        void advance() {
+            ++pos_;
         }
 
-        virtual TypedIterator<Value>::Ptr iteratorTyped() const {
-            LIBJ_THROW(Error::UNSUPPORTED_OPERATION);
-            return TypedIterator<Value>::null();
+        static Boolean accepts(const Value& key) {
+            return true;
         }
 
      private:
-        const typename detail::Map<I>* self_;
+        const Container* map_;
+        CItr pos_;
+        CItr end_;
     };
 
-    class Entry : public EntryT {
-        LIBJ_MUTABLE_TEMPLATE_DEFS(Entry, EntryT);
-
-     public:
-        void setKey(const Value& key) {
-            key_ = key;
-        }
-
-        void setValue(const Value& val) {
-            val_ = val;
-        }
-
-        virtual Value getKey() const {
-            return key_;
-        }
+    typedef MapKeySet<SlotCursor> KeySet;
+    typedef MapEntrySet<SlotCursor> EntrySet;
 
-        virtual Value getValue() const {
-            return val_;
-        }
-
-        virtual String::CPtr toString() const {
-            return String::create();
-        }
-
-     private:
-        Value key_;
-        Value val_;
-    };
-
-    class EntrySet
-        : public GenericCollection<EntrySetT, typename EntryT::CPtr> {
-     public:
-        EntrySet(const typename detail::Map<I>* self) : self_(self) {}
-
-        virtual Size size() const {
-            return self_->size();
-        }
-
-        virtual Iterator::Ptr iterator() const {
-            return Iterator::Ptr(new TypedEntryIterator(self_->map_));
-        }
-
-        virtual typename EntryIteratorT::Ptr iteratorTyped() const {
-            return typename EntryIteratorT::Ptr(
-                new TypedEntryIterator(self_->map_));
-        }
-
-     public:
-        class TypedEntryIterator : public EntryIteratorT {
-            friend class EntrySet;
-
-         public:
-            virtual Boolean hasNext() const {
-                return map_ && pos_ != end_;
-            }
-
-            virtual Value next() {
-                if (!map_ || pos_ == end_) {
-                    LIBJ_HANDLE_ERROR(Error::NO_SUCH_ELEMENT);
-                } else {
-                    entry_->setKey(pos_->first);
-                    entry_->setValue(pos_->second);
-                    ++pos_;
-                    return typename Entry::CPtr(entry_);
-                }
-            }
-
-            virtual typename EntryT::CPtr nextTyped() {
-                if (!map_ || pos_ == end_) {
-                    LIBJ_THROW(Error::NO_SUCH_ELEMENT);
-                }
-
-                entry_->setKey(pos_->first);
-                entry_->setValue(pos_->second);
-                ++pos_;
-                return typename Entry::CPtr(entry_);
-            }
-
-            virtual String::CPtr toString() const {
-                return String::create();
-            }
-
-         private:
-            const typename Map<I>::Container* map_;
-            typename Map<I>::CItr pos_;
-            typename Map<I>::CItr end_;
-
-            // reuse Entry for better performance
-            typename Entry::Ptr entry_;
-
-            TypedEntryIterator(const typename Map<I>::Container* map)
-                : map_(map)
-                , pos_(map ? map->begin() : typename Map<I>::CItr())
-                , end_(map ? map->end() : typename Map<I>::CItr())
-                , entry_(map ? new Entry() : NULL) {}
-        };
-
-     public:
-        virtual void clear() {
-            LIBJ_THROW(Error::UNSUPPORTED_OPERATION);
-        }
-
-        virtual Boolean add(const Value& v) {
-            LIBJ_THROW(Error::UNSUPPORTED_OPERATION);
-            return false;
-        }
-
-        virtual Boolean remove(const Value& v) {
-            LIBJ_THROW(Error::UNSUPPORTED_OPERATION);
-            return false;
-        }
-
-        virtual Boolean addTyped(const typename EntryT::CPtr& v) {
-            LIBJ_THROW(Error::UNSUPPORTED_OPERATION);
-            return false;
-        }
-
-        virtual Boolean removeTyped(const typename EntryT::CPtr& v) {
-            LIBJ_THROW(Error::UNSUPPORTED_OPERATION);
+ private:
+    // whether key is absent and goes right before hint
+    Boolean fits(Itr hint, const Value& key) const {
+        if (hint != map_->end() && !map_->key_comp()(key, hint->first)) {
             return false;
+        } else if (hint == map_->begin()) {
+            return true;
+        } else {
+            --hint;
+            return map_->key_comp()(hint->first, key);
         }
+    }
 
-     private:
-        const typename detail::Map<I>* self_;
-    };
-
- private:
     Value _get(const Value& key) const {
         if (!map_) return UNDEFINED;
 
@@ -0,0 +1,239 @@
+// Copyright (c) 2013 Plenluno All rights reserved.
+
+#ifndef LIBJ_DETAIL_MAP_VIEW_H_
+#define LIBJ_DETAIL_MAP_VIEW_H_
+
+#include <libj/map.h>
+#include <libj/detail/generic_collection.h>
+
+namespace libj {
+namespace detail {
+
+// the key set and the entry set of a map, which read the entries of
+// the map through a cursor C. C walks the entries of C::Owner,
+// the map, as follows.
+//
+//   C(const Owner* self)      starts at the first entry of self
+//   hasNext()                 whether there is an entry at the cursor
+//   key(), value()            the entry at the cursor
+//   advance()                 moves the cursor to the next entry
+//   static accepts(key)       whether key may be in Owner at all,
+//                             as containsKey converts some keys
+
+template<typename C>
+class MapKeySet : public GenericCollection<Set, Value> {
+ public:
+    typedef typename C::Owner Owner;
+
+    MapKeySet(const Owner* self) : self_(self) {}
+
+    virtual Size size() const {
+        return self_->size();
+    }
+
+    virtual Boolean contains(const Value& v) const {
+        return C::accepts(v) && self_->containsKey(v);
+    }
+
+    virtual Iterator::Ptr iterator() const {
+        return Iterator::Ptr(new KeyIterator(self_));
+    }
+
+ public:
+    class KeyIterator : public Iterator {
+        friend class MapKeySet;
+
+     public:
+        virtual Boolean hasNext() const {
+            return cursor_.hasNext();
+        }
+
+        virtual Value next() {
+            if (!cursor_.hasNext()) {
+                LIBJ_HANDLE_ERROR(Error::NO_SUCH_ELEMENT);
+            } else {
+                Value key = cursor_.key();
+                cursor_.advance();
+                return key;
+            }
+        }
+
+        virtual String::CPtr toString() const {
+            return String::create();
+        }
+
+     private:
+        C cursor_;
+
+        KeyIterator(const Owner* self) : cursor_(self) {}
+    };
+
+ public:
+    virtual void clear() {
+        LIBJ_THROW(Error::UNSUPPORTED_OPERATION);
+    }
+
+    virtual Boolean add(const Value& v) {
+        LIBJ_THROW(Error::UNSUPPORTED_OPERATION);
+        return false;
+    }
+
+    virtual Boolean remove(const Value& v) {
+        LIBJ_THROW(Error::UNSUPPORTED_OPERATION);
+        return false;
+    }
+
+    virtual Boolean addTyped(const Value& v) {
+        LIBJ_THROW(Error::UNSUPPORTED_OPERATION);
+        return false;
+    }
+
+    virtual Boolean removeTyped(const Value& v) {
+        LIBJ_THROW(Error::UNSUPPORTED_OPERATION);
+        return false;
+    }
+
+    virtual TypedIterator<Value>::Ptr iteratorTyped() const {
+        LIBJ_THROW(Error::UNSUPPORTED_OPERATION);
+        return TypedIterator<Value>::null();
+    }
+
+ private:
+    const Owner* self_;
+};
+
+template<typename C>
+class MapEntrySet
+    : public GenericCollection<
+        TypedSet<libj::Map::Entry::CPtr>, libj::Map::Entry::CPtr> {
+ public:
+    typedef typename C::Owner Owner;
+
+ private:
+    typedef libj::Map::Entry EntryT;
+    typedef TypedIterator<EntryT::CPtr> EntryIteratorT;
+
+ public:
+    MapEntrySet(const Owner* self) : self_(self) {}
+
+    virtual Size size() const {
+        return self_->size();
+    }
+
+    virtual Iterator::Ptr iterator() const {
+        return Iterator::Ptr(new TypedEntryIterator(self_));
+    }
+
+    virtual EntryIteratorT::Ptr iteratorTyped() const {
+        return EntryIteratorT::Ptr(new TypedEntryIterator(self_));
+    }
+
+ public:
+    class Entry : public EntryT {
+        LIBJ_MUTABLE_TEMPLATE_DEFS(Entry, EntryT);
+
+     public:
+        void setKey(const Value& key) {
+            key_ = key;
+        }
+
+        void setValue(const Value& val) {
+            val_ = val;
+        }
+
+        virtual Value getKey() const {
+            return key_;
+        }
+
+        virtual Value getValue() const {
+            return val_;
+        }
+
+        virtual String::CPtr toString() const {
+            return String::create();
+        }
+
+     private:
+        Value key_;
+        Value val_;
+    };
+
+    class TypedEntryIterator : public EntryIteratorT {
+        friend class MapEntrySet;
+
+     public:
+        virtual Boolean hasNext() const {
+            return cursor_.hasNext();
+        }
+
+        virtual Value next() {
+            if (!cursor_.hasNext()) {
+                LIBJ_HANDLE_ERROR(Error::NO_SUCH_ELEMENT);
+            } else {
+                return nextEntry();
+            }
+        }
+
+        virtual EntryT::CPtr nextTyped() {
+            if (!cursor_.hasNext()) {
+                LIBJ_THROW(Error::NO_SUCH_ELEMENT);
+            }
+
+            return nextEntry();
+        }
+
+        virtual String::CPtr toString() const {
+            return String::create();
+        }
+
+     private:
+        C cursor_;
+
+        // reuse Entry for better performance
+        typename Entry::Ptr entry_;
+
+        TypedEntryIterator(const Owner* self)
+            : cursor_(self)
+            , entry_(new Entry()) {}
+
+        typename Entry::CPtr nextEntry() {
+            entry_->setKey(cursor_.key());
+            entry_->setValue(cursor_.value());
+            cursor_.advance();
+            return typename Entry::CPtr(entry_);
+        }
+    };
+
+ public:
+    virtual void clear() {
+        LIBJ_THROW(Error::UNSUPPORTED_OPERATION);
+    }
+
+    virtual Boolean add(const Value& v) {
+        LIBJ_THROW(Error::UNSUPPORTED_OPERATION);
+        return false;
+    }
+
+    virtual Boolean remove(const Value& v) {
+        LIBJ_THROW(Error::UNSUPPORTED_OPERATION);
+        return false;
+    }
+
+    virtual Boolean addTyped(const EntryT::CPtr& v) {
+        LIBJ_THROW(Error::UNSUPPORTED_OPERATION);
+        return false;
+    }
+
+    virtual Boolean removeTyped(const EntryT::CPtr& v) {
+        LIBJ_THROW(Error::UNSUPPORTED_OPERATION);
+        return false;
+    }
+
+ private:
+    const Owner* self_;
+};
+
+}  // namespace detail
+}  // namespace libj
+
+#endif  // LIBJ_DETAIL_MAP_VIEW_H_
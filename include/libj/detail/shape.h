@@ -0,0 +1,293 @@
+// Copyright (c) 2013 Plenluno All rights reserved.
+
+#ifndef LIBJ_DETAIL_SHAPE_H_
+#define LIBJ_DETAIL_SHAPE_H_
+
+#include <libj/detail/hash_table.h>
+#include <libj/detail/noncopyable.h>
+
+#ifdef LIBJ_USE_THREAD
+# include <libj/detail/atomic.h>
+# include <libj/detail/scoped_lock.h>
+#endif
+
+#include <vector>
+
+namespace libj {
+namespace detail {
+
+// the keys of an object in insertion order, each of which is mapped to
+// the index of its value in the slots of the object.
+//
+// a shared shape never changes. adding a key to it leads to the child
+// shape for the key, which is created on the first transition and then
+// shared by all the objects that add the same keys in the same order.
+// the shared shapes live as long as the program, like strong symbols,
+// and there are at most MAX_SHARED_SHAPES of them besides the root,
+// which takes the reserved id ROOT_ID outside of the limit.
+//
+// an object turns its shape into an unshared one (dictionary mode)
+// when it removes a key other than the last one, when it has too many
+// keys, when its shape has too many transitions, or when no more shared
+// shapes can be created, so that objects used as dictionaries, or whose
+// keys vary, do not grow the tree of the shared shapes without bound.
+// an unshared shape belongs to one object and is changed in place.
+// removing a key from it leaves a hole at the index of the key,
+// so that the indices of the others stay, until compact is called.
+class Shape : private NonCopyable {
+ public:
+    static const Size MAX_SHARED_SIZE = 64;
+    static const Size MAX_TRANSITIONS = 32;
+    static const Size MAX_SHARED_SHAPES = 4096;
+    static const Size MIN_COMPACTED_HOLES = 8;
+
+    // the shape of an empty object
+    static Shape* root() {
+        static Shape* r = new Shape(NULL, ROOT_ID);
+        assert(r->isShared());
+        return r;
+    }
+
+    // the number of the shared shapes created so far, except the root
+    static Size numSharedShapes() {
+#ifdef LIBJ_USE_THREAD
+        Size n = lastId().load(LIBJ_DETAIL_MEMORY_ORDER(relaxed));
+#else
+        Size n = lastId();
+#endif
+        n -= ROOT_ID;
+        if (n > MAX_SHARED_SHAPES) n = MAX_SHARED_SHAPES;
+        return n;
+    }
+
+    // no shared shape is created once numSharedShapes() reaches limit,
+    // which is at most MAX_SHARED_SHAPES. returns the previous limit.
+    // the tests lower it for a while to run out of the shared shapes
+    // without using them up for good. the root is not counted,
+    // so that it stays shared whenever the limit is set.
+    static Size setSharedShapesLimit(Size limit) {
+        if (limit > MAX_SHARED_SHAPES) limit = MAX_SHARED_SHAPES;
+#ifdef LIBJ_USE_THREAD
+        return idLimit().exchange(limit, LIBJ_DETAIL_MEMORY_ORDER(relaxed));
+#else
+        Size prev = idLimit();
+        idLimit() = limit;
+        return prev;
+#endif
+    }
+
+    Boolean isShared() const {
+        return shared_;
+    }
+
+    // a cache entry packs the id of a shared shape with the index of
+    // one of its keys. it is never 0, which no shape accepts.
+    // the ids are at most ROOT_ID + MAX_SHARED_SHAPES,
+    // so that they never wrap.
+
+    Size cacheEntry(Size index) const {
+        assert(index < MAX_SHARED_SIZE);
+        return shared_ ? id_ << 8 | index : 0;
+    }
+
+    // returns NO_POS unless entry is made by this shape
+    Size cachedIndex(Size entry) const {
+        return shared_ && entry >> 8 == id_ ? entry & 0xff : NO_POS;
+    }
+
+    // the number of the keys
+    Size size() const {
+        return keys_.size() - holes_;
+    }
+
+    // the number of the keys and the holes
+    Size length() const {
+        return keys_.size();
+    }
+
+    // returns UNDEFINED at a hole
+    const Value& keyAt(Size index) const {
+        return keys_[index];
+    }
+
+    // returns NO_POS if key is not in this shape
+    Size indexOf(const Value& key) const {
+        Index* i = index_.find(key);
+        return i ? i->index : NO_POS;
+    }
+
+    // the following return the shape that replaces this one,
+    // which is deleted if it is unshared and not returned
+
+    // returns the shape with key added at the index length()
+    Shape* add(const Value& key) {
+        if (shared_) {
+            Shape* child = transition(key);
+            if (child) return child;
+
+            Shape* s = unshare();
+            s->append(key);
+            return s;
+        } else {
+            append(key);
+            return this;
+        }
+    }
+
+    // returns the shape with the key at index removed.
+    // the last key of a shared shape is removed by going back to its
+    // parent, and the others leave a hole in an unshared shape.
+    Shape* remove(Size index) {
+        assert(index < keys_.size() && !keys_[index].isUndefined());
+        if (shared_ && index + 1 == keys_.size()) return parent_;
+
+        Shape* s = shared_ ? unshare() : this;
+        s->index_.erase(s->keys_[index]);
+        s->keys_[index] = UNDEFINED;
+        s->holes_++;
+        return s;
+    }
+
+    // returns true if the holes are worth compacting,
+    // which they are when they outnumber the keys
+    Boolean isSparse() const {
+        return holes_ >= MIN_COMPACTED_HOLES && holes_ > size();
+    }
+
+    // removes the holes of an unshared shape, moving the keys forward
+    void compact() {
+        assert(!shared_);
+        Size n = 0;
+        for (Size i = 0; i < keys_.size(); i++) {
+            if (!keys_[i].isUndefined()) keys_[n++] = keys_[i];
+        }
+        keys_.resize(n);
+        holes_ = 0;
+        reindex();
+    }
+
+    // deletes this shape if it is unshared
+    void release() {
+        if (!shared_) delete this;
+    }
+
+ private:
+    struct Index {
+        Value key;
+        Size index;
+    };
+
+    struct Transition {
+        Value key;
+        Shape* shape;
+    };
+
+    // an unshared shape has no id
+    Shape(Shape* parent, Size id)
+        : parent_(parent)
+        , shared_(!!id)
+        , id_(id)
+        , holes_(0) {}
+
+    static const Size ROOT_ID = 1;
+
+#ifdef LIBJ_USE_THREAD
+    typedef LIBJ_DETAIL_ATOMIC(Size) IdCounter;
+#else
+    typedef Size IdCounter;
+#endif
+
+    // starts from ROOT_ID, which newId never returns
+    static IdCounter& lastId() {
+        static IdCounter last(ROOT_ID);
+        return last;
+    }
+
+    static IdCounter& idLimit() {
+        static IdCounter limit(MAX_SHARED_SHAPES);
+        return limit;
+    }
+
+    // returns the id of a new shared shape,
+    // or 0 if the limit of the shared shapes is reached.
+    // the ids are never reused even if the limit is raised again.
+    static Size newId() {
+#ifdef LIBJ_USE_THREAD
+        Size limit = idLimit().load(LIBJ_DETAIL_MEMORY_ORDER(relaxed));
+        Size n = lastId().load(LIBJ_DETAIL_MEMORY_ORDER(relaxed));
+        if (n >= ROOT_ID + limit) return 0;
+
+        n = lastId().fetch_add(1, LIBJ_DETAIL_MEMORY_ORDER(relaxed)) + 1;
+        return n <= ROOT_ID + limit ? n : 0;
+#else
+        IdCounter& last = lastId();
+        return last < ROOT_ID + idLimit() ? ++last : 0;
+#endif
+    }
+
+    // returns NULL if this shape cannot have the child for key
+    Shape* transition(const Value& key) {
+#ifdef LIBJ_USE_THREAD
+        ScopedLock lock(mutex_);
+#endif
+        Transition* t = transitions_.find(key);
+        if (t) return t->shape;
+
+        if (keys_.size() >= MAX_SHARED_SIZE ||
+            transitions_.size() >= MAX_TRANSITIONS) {
+            return NULL;
+        }
+
+        Size id = newId();
+        if (!id) return NULL;
+
+        Shape* child = new Shape(this, id);
+        child->keys_ = keys_;
+        child->reindex();
+        child->append(key);
+
+        Boolean inserted;
+        transitions_.insert(key, &inserted)->shape = child;
+        return child;
+    }
+
+    Shape* unshare() const {
+        Shape* s = new Shape(NULL, 0);
+        s->keys_ = keys_;
+        s->reindex();
+        return s;
+    }
+
+    void append(const Value& key) {
+        Boolean inserted;
+        index_.insert(key, &inserted)->index = keys_.size();
+        assert(inserted);
+        keys_.push_back(key);
+    }
+
+    void reindex() {
+        index_.clear();
+        Size n = keys_.size();
+        for (Size i = 0; i < n; i++) {
+            Boolean inserted;
+            index_.insert(keys_[i], &inserted)->index = i;
+        }
+    }
+
+ private:
+    Shape* parent_;
+    Boolean shared_;
+    Size id_;
+    Size holes_;
+    std::vector<Value> keys_;
+    HashTable<Index> index_;
+    HashTable<Transition> transitions_;
+#ifdef LIBJ_USE_THREAD
+    Mutex mutex_;
+#endif
+};
+
+}  // namespace detail
+}  // namespace libj
+
+#endif  // LIBJ_DETAIL_SHAPE_H_
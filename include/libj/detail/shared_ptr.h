@@ -1,8 +1,10 @@
-// Copyright (c) 2012 Plenluno All rights reserved.
+// Copyright (c) 2012-2013 Plenluno All rights reserved.
 
 #ifndef LIBJ_DETAIL_SHARED_PTR_H_
 #define LIBJ_DETAIL_SHARED_PTR_H_
 
+#include <libj/config.h>
+
 #if defined(LIBJ_USE_CXX11) && !defined(LIBJ_USE_CLANG)
 
 #include <memory>
@@ -10,18 +12,48 @@
 namespace libj {
 namespace detail {
 
+// without threads, the reference counts of libstdc++ need not be atomic
+#if defined(LIBJ_USE_GCC) && !defined(LIBJ_USE_THREAD)
+
+template<typename T>
+struct SharedPtr {
+    typedef std::__shared_ptr<T, __gnu_cxx::_S_single> Type;
+};
+
+template<typename T>
+struct EnableSharedFromThis {
+    typedef std::__enable_shared_from_this<T, __gnu_cxx::_S_single> Type;
+};
+
+#else
+
 template<typename T>
 struct SharedPtr {
     typedef std::shared_ptr<T> Type;
 };
 
+template<typename T>
+struct EnableSharedFromThis {
+    typedef std::enable_shared_from_this<T> Type;
+};
+
+#endif
+
 }  // namespace detail
 }  // namespace libj
 
 #else  // LIBJ_USE_CXX11
 
+// the counts of boost::shared_ptr are not atomic without threads.
+// BOOST_SP_DISABLE_THREADS changes the layout of boost::shared_ptr,
+// so CMakeLists.txt defines it for the whole build, not here.
+#if !defined(LIBJ_USE_THREAD) && !defined(BOOST_SP_DISABLE_THREADS)
+# error "define BOOST_SP_DISABLE_THREADS in all the sources without threads"
+#endif
+
 #define LIBJ_DISABLE_BOOST_SP_GET_DELETER
 #include "boost/shared_ptr.hpp"
+#include "boost/enable_shared_from_this.hpp"
 
 namespace libj {
 namespace detail {
@@ -31,6 +63,11 @@ struct SharedPtr {
     typedef boost::shared_ptr<T> Type;
 };
 
+template<typename T>
+struct EnableSharedFromThis {
+    typedef boost::enable_shared_from_this<T> Type;
+};
+
 }  // namespace detail
 }  // namespace libj
 
@@ -0,0 +1,55 @@
+// Copyright (c) 2013 Plenluno All rights reserved.
+
+#ifndef LIBJ_DETAIL_SIMD_H_
+#define LIBJ_DETAIL_SIMD_H_
+
+#include <libj/typedef.h>
+
+namespace libj {
+namespace detail {
+namespace simd {
+
+// kernels over the characters of strings.
+// the fastest implementation supported by the cpu is chosen at run time.
+// the positions returned are NO_POS if nothing is found.
+
+Size find(const Char* s, Size n, Char c);
+
+Size findLast(const UByte* s, Size n, UByte c);
+
+Size findLast(const Char* s, Size n, Char c);
+
+// finds the first character in [lo, hi]
+Size findRange(const UByte* s, Size n, UByte lo, UByte hi);
+
+Size findRange(const Char* s, Size n, Char lo, Char hi);
+
+// finds the first i < n such that s[i] == first and s[i + gap] == last
+Size findPair(const UByte* s, Size n, UByte first, UByte last, Size gap);
+
+Size findPair(const Char* s, Size n, Char first, Char last, Size gap);
+
+// copies the leading characters in [1, 0x7f] to d and returns their number.
+// d must have room for n characters, which may all be overwritten.
+Size widenAscii(const UByte* s, Size n, char16_t* d);
+
+Size widenAscii(const UByte* s, Size n, char32_t* d);
+
+Size narrowAscii(const char16_t* s, Size n, UByte* d);
+
+Size narrowAscii(const char32_t* s, Size n, UByte* d);
+
+void replace(UByte* s, Size n, UByte oldC, UByte newC);
+
+void replace(Char* s, Size n, Char oldC, Char newC);
+
+// adds diff to every character in [lo, hi]
+void shiftRange(UByte* s, Size n, UByte lo, UByte hi, Int diff);
+
+void shiftRange(Char* s, Size n, Char lo, Char hi, Int diff);
+
+}  // namespace simd
+}  // namespace detail
+}  // namespace libj
+
+#endif  // LIBJ_DETAIL_SIMD_H_
@@ -8,25 +8,30 @@
 #include <libj/debug_print.h>
 #include <libj/endian.h>
 #include <libj/exception.h>
+#include <libj/js_regexp.h>
 #include <libj/string.h>
 #include <libj/this.h>
 #include <libj/typed_iterator.h>
 #include <libj/glue/cvtutf.h>
 
+#include <libj/detail/simd.h>
+#include <libj/detail/string_search.h>
+#include <libj/detail/symbol_table.h>
+
 #ifdef LIBJ_USE_THREAD
-# include <libj/concurrent_map.h>
-#else
-# include <libj/map.h>
+# include <libj/detail/atomic.h>
+# include <libj/detail/scoped_lock.h>
 #endif
 
 #include <assert.h>
+#include <string.h>
 #include <string>
 #include <vector>
 
 namespace libj {
 namespace detail {
 
-glue::UnicodeEncoding convertStrEncoding(libj::String::Encoding enc) {
+inline glue::UnicodeEncoding convertStrEncoding(libj::String::Encoding enc) {
     static Endian e = endian();
 
     switch (enc) {
@@ -58,100 +63,123 @@ glue::UnicodeEncoding convertStrEncoding(libj::String::Encoding enc) {
     }
 }
 
+template<typename I>
+class StringBuilder;
+
 #define LIBJ_DETAIL_STRING(S) static_cast<const String*>(&(*S))
-#define LIBJ_INTERNAL_STRING(S) (LIBJ_DETAIL_STRING(S)->str_)
 
+// a string whose characters all fit in one byte (Latin-1) is stored
+// one byte per character. short strings are stored inline.
+// the characters are always null-terminated.
+//
+// concat creates a cons string which refers to both operands and
+// has no characters until it is flattened on the first access.
+//
+// substring creates a slice which shares the characters of its parent
+// if it is long enough. slices are not null-terminated.
+//
+// the operands of a cons string and the parent of a slice are kept in
+// a separate Link, so that flat strings do not pay for them.
 class String : public libj::String {
     typedef TypedIterator<Char> Iterator;
 
 #ifdef LIBJ_USE_UTF16
-
     typedef std::u16string ustring;
+#else
+    typedef std::u32string ustring;
+#endif
 
  public:
-    String(const std::u16string& s16)
-        : str_(s16)
-        , interned_(false) {}
-
-    String(const std::u32string& s32)
-        : str_(glue::utf32ToUtf16(s32))
-        , interned_(false) {}
-
-    String(
-        const void* data, Encoding enc, Size len, Size max)
-        : str_(glue::toUtf16(data, convertStrEncoding(enc), len, max))
-        , interned_(false) {}
-
-    virtual std::string toStdString(Encoding enc) const {
-        return glue::fromUtf16(str_, convertStrEncoding(enc));
+    String() {
+        init();
+        allocate(0, true);
     }
 
-    virtual std::u16string toStdU16String() const {
-        return str_;
+    String(Char c, Size n) {
+        init();
+        if (c <= MAX_ONE_BYTE) {
+            memset(allocate(n, true), static_cast<UByte>(c), n);
+        } else {
+            Char* d = static_cast<Char*>(allocate(n, false));
+            for (Size i = 0; i < n; i++) {
+                d[i] = c;
+            }
+        }
     }
 
-    virtual std::u32string toStdU32String() const {
-        return glue::utf16ToUtf32(str_);
+    String(const std::u16string& s16) {
+        init();
+#ifdef LIBJ_USE_UTF16
+        assign(s16.data(), s16.length());
+#else
+        ustring s32 = glue::utf16ToUtf32(s16);
+        assign(s32.data(), s32.length());
+#endif
     }
 
-#else  // LIBJ_USE_UTF16
-
-    typedef std::u32string ustring;
-
- public:
-    String(const std::u16string& s16)
-        : str_(glue::utf16ToUtf32(s16))
-        , interned_(false) {}
-
-    String(const std::u32string& s32)
-        : str_(s32)
-        , interned_(false) {}
+    String(const std::u32string& s32) {
+        init();
+#ifdef LIBJ_USE_UTF16
+        ustring s16 = glue::utf32ToUtf16(s32);
+        assign(s16.data(), s16.length());
+#else
+        assign(s32.data(), s32.length());
+#endif
+    }
 
-    String(
-        const void* data, Encoding enc, Size len, Size max)
-        : str_(glue::toUtf32(data, convertStrEncoding(enc), len, max))
-        , interned_(false) {}
+    String(const void* data, Encoding enc, Size len, Size max) {
+        init();
+        if (enc == UTF8 &&
+            assignAscii(static_cast<const char*>(data), len, max)) {
+            return;
+        }
 
-    virtual std::string toStdString(Encoding enc) const {
-        return glue::fromUtf32(str_, convertStrEncoding(enc));
+#ifdef LIBJ_USE_UTF16
+        ustring s = glue::toUtf16(data, convertStrEncoding(enc), len, max);
+#else
+        ustring s = glue::toUtf32(data, convertStrEncoding(enc), len, max);
+#endif
+        assign(s.data(), s.length());
     }
 
-    virtual std::u16string toStdU16String() const {
-        return glue::utf32ToUtf16(str_);
+    String(const String& other) {
+        init();
+        copy(other, 0, other.length_);
+        hash_ = static_cast<UInt>(other.peekHash());
     }
 
-    virtual std::u32string toStdU32String() const {
-        return str_;
+    String(const String& other, Size pos, Size count = NO_POS) {
+        init();
+        assert(pos <= other.length_);
+        Size n = other.length_ - pos;
+        copy(other, pos, count < n ? count : n);
     }
 
-#endif  // LIBJ_USE_UTF16
-
- public:
-    String()
-        : str_()
-        , interned_(false) {}
-
-    String(Char c, Size n)
-        : str_(n, c)
-        , interned_(false) {}
-
-    String(const String& other)
-        : str_(other.str_)
-        , interned_(false) {}
-
-    String(const String& other, Size pos, Size count = NO_POS)
-        : str_(other.str_, pos, count)
-        , interned_(false) {}
+    virtual ~String() {
+#ifdef LIBJ_USE_THREAD
+        void* c = chars_.load();
+        delete[] wide_.load();
+#else
+        void* c = chars_;
+        delete[] wide_;
+#endif
+        if (c != &inline_ && !sliced_) {
+            delete[] static_cast<UByte*>(c);
+        }
+        release(link_);
+    }
 
     virtual Size length() const {
-        return str_.length();
+        return length_;
     }
 
     virtual Char charAt(Size index) const {
-        if (index >= length()) {
+        if (index >= length_) {
             return NO_CHAR;
+        } else if (oneByte_) {
+            return bytes()[index];
         } else {
-            return str_.at(index);
+            return wides()[index];
         }
     }
 
@@ -164,8 +192,23 @@ class String : public libj::String {
             return other->toString();
         }
 
-        String* s = new String(*this);
-        s->str_ += LIBJ_INTERNAL_STRING(other);
+        const String* that = LIBJ_DETAIL_STRING(other);
+        String* s = new String();
+        Size len = length_ + that->length_;
+        if (len >= CONS_MIN_LENGTH) {
+            s->length_ = len;
+            s->oneByte_ = oneByte_ && that->oneByte_;
+            s->setChars(NULL);
+            s->link_ = new Link(toString(), other);
+        } else if (oneByte_ && that->oneByte_) {
+            UByte* d = static_cast<UByte*>(s->allocate(len, true));
+            copyTo(d, 0, length_);
+            that->copyTo(d + length_, 0, that->length_);
+        } else {
+            Char* d = static_cast<Char*>(s->allocate(len, false));
+            copyTo(d, 0, length_);
+            that->copyTo(d + length_, 0, that->length_);
+        }
         return CPtr(s);
     }
 
@@ -177,9 +220,9 @@ class String : public libj::String {
         }
 
         assert(!!that);
-        CPtr other = LIBJ_STATIC_CPTR_CAST(libj::String)(that);
-        assert(!isInterned() || !other->isInterned() || this != &(*other));
-        return str_.compare(LIBJ_INTERNAL_STRING(other));
+        const String* other = LIBJ_DETAIL_STRING(that);
+        assert(!isInterned() || !other->isInterned() || this != other);
+        return dispatch(this, other, Compare(0, length_, other->length_));
     }
 
     virtual Boolean equals(Object::CPtr that) const {
@@ -190,97 +233,182 @@ class String : public libj::String {
         }
 
         assert(!!that);
-        CPtr other = LIBJ_STATIC_CPTR_CAST(libj::String)(that);
-        assert(!isInterned() || !other->isInterned() || this != &(*other));
-        return str_ == LIBJ_INTERNAL_STRING(other);
+        const String* other = LIBJ_DETAIL_STRING(that);
+        assert(!isInterned() || !other->isInterned() || this != other);
+        if (length_ != other->length_) return false;
+
+        // distinct symbols never have the same characters
+        if (interned_ && other->interned_) return false;
+
+        Size h1 = peekHash();
+        Size h2 = other->peekHash();
+        return (!h1 || !h2 || h1 == h2)
+            && !dispatch(this, other, Compare(0, length_, length_));
+    }
+
+    // the hash code is computed from the characters on the first call.
+    // it does not depend on how the characters are stored.
+    virtual Size hashCode() const {
+        Size h = peekHash();
+        if (!h) {
+            UInt u = oneByte_ ? hash(bytes()) : hash(wides());
+#ifdef LIBJ_USE_THREAD
+            hash_.store(u, LIBJ_DETAIL_MEMORY_ORDER(relaxed));
+#else
+            hash_ = u;
+#endif
+            h = u;
+        }
+        return h;
     }
 
     virtual Boolean startsWith(CPtr other, Size from) const {
         if (!other) return false;
 
-        return !str_.compare(
-            from,
-            other->length(),
-            LIBJ_INTERNAL_STRING(other));
+        const String* that = LIBJ_DETAIL_STRING(other);
+        Size len = that->length_;
+        return from <= length_
+            && len <= length_ - from
+            && !dispatch(this, that, Compare(from, len, len));
     }
 
     virtual Boolean endsWith(CPtr other) const {
         if (!other) return false;
 
-        Size len1 = this->length();
-        Size len2 = other->length();
-        if (len1 < len2) {
-            return false;
-        }
-
-        return !str_.compare(
-            len1 - len2,
-            len2,
-            LIBJ_INTERNAL_STRING(other));
+        const String* that = LIBJ_DETAIL_STRING(other);
+        Size len = that->length_;
+        return len <= length_
+            && !dispatch(this, that, Compare(length_ - len, len, len));
     }
 
     virtual Size indexOf(Char c, Size from) const {
-        return str_.find_first_of(c, from);
+        if (from >= length_) return NO_POS;
+
+        if (oneByte_) {
+            if (c > MAX_ONE_BYTE) return NO_POS;
+
+            const UByte* s = bytes();
+            const void* p = memchr(s + from, c, length_ - from);
+            return p ? static_cast<const UByte*>(p) - s : NO_POS;
+        } else {
+            Size i = simd::find(wides() + from, length_ - from, c);
+            return i == NO_POS ? NO_POS : from + i;
+        }
     }
 
     virtual Size indexOf(CPtr other, Size from) const {
         if (!other) return NO_POS;
 
-        return str_.find(LIBJ_INTERNAL_STRING(other), from);
+        const String* that = LIBJ_DETAIL_STRING(other);
+        return dispatch(this, that, Find(length_, that->length_, from));
+    }
+
+    // returns the shift table to search for this string
+    ShiftTable shiftTable() const {
+        if (oneByte_) {
+            return ShiftTable(bytes(), length_);
+        } else {
+            return ShiftTable(wides(), length_);
+        }
+    }
+
+    // finds pattern using its shift table
+    Size indexOf(
+        const String* pattern, const ShiftTable& shifts, Size from) const {
+        return dispatch(
+            this, pattern, Find(length_, pattern->length_, from, &shifts));
     }
 
     virtual Size lastIndexOf(Char c, Size from) const {
-        return str_.find_last_of(c, from);
+        if (!length_) return NO_POS;
+
+        Size n = from < length_ ? from + 1 : length_;
+        if (oneByte_) {
+            if (c > MAX_ONE_BYTE) return NO_POS;
+
+            return simd::findLast(bytes(), n, static_cast<UByte>(c));
+        } else {
+            return simd::findLast(wides(), n, c);
+        }
     }
 
     virtual Size lastIndexOf(CPtr other, Size from) const {
         if (!other) return NO_POS;
 
-        return str_.rfind(LIBJ_INTERNAL_STRING(other), from);
+        const String* that = LIBJ_DETAIL_STRING(other);
+        return dispatch(this, that, RFind(length_, that->length_, from));
     }
 
-    virtual CPtr toLowerCase() const {
-        String* s = NULL;
-        Size len = length();
-        for (Size i = 0; i < len; i++) {
-            Char c = str_.at(i);
-            if (c >= 'A' && c <= 'Z') {
-                c += 'a' - 'A';
-                if (!s) {
-                    s = new String(*this, 0, i);
-                }
-            }
-            if (s) {
-                s->str_ += c;
-            }
-        }
-        if (s) {
-            return CPtr(s);
-        } else {
-            return toString();
+    virtual JsArray::Ptr split(
+        Char separator, Size limit, Boolean share) const {
+        JsArray::Ptr res = JsArray::create();
+        if (!limit) return res;
+
+        Size prev = 0;
+        Size curr = indexOf(separator, 0);
+        while (curr != NO_POS) {
+            res->add(piece(prev, curr - prev, share));
+            if (res->size() == limit) return res;
+
+            prev = curr + 1;
+            curr = indexOf(separator, prev);
         }
+        res->add(piece(prev, length_ - prev, share));
+        return res;
     }
 
-    virtual CPtr toUpperCase() const {
-        String* s = NULL;
-        Size len = length();
-        for (Size i = 0; i < len; i++) {
-            Char c = str_.at(i);
-            if (c >= 'a' && c <= 'z') {
-                c -= 'a' - 'A';
-                if (!s) {
-                    s = new String(*this, 0, i);
-                }
-            }
-            if (s) {
-                s->str_ += c;
+    virtual JsArray::Ptr split(
+        CPtr separator, Size limit, Boolean share) const {
+        JsArray::Ptr res = JsArray::create();
+        if (!limit) return res;
+
+        if (!separator) {
+            res->add(toString());
+            return res;
+        }
+
+        const String* sep = LIBJ_DETAIL_STRING(separator);
+        Size len = sep->length_;
+        if (!len) {
+            for (Size i = 0; i < length_ && i < limit; i++) {
+                res->add(piece(i, 1, share));
             }
+            return res;
         }
-        if (s) {
-            return CPtr(s);
-        } else {
-            return toString();
+
+        ShiftTable shifts;
+        Boolean horspool = len >= HORSPOOL_MIN_LENGTH;
+        if (horspool) shifts = sep->shiftTable();
+
+        Size prev = 0;
+        Size curr = horspool
+            ? indexOf(sep, shifts, 0)
+            : indexOf(separator, 0);
+        while (curr != NO_POS) {
+            res->add(piece(prev, curr - prev, share));
+            if (res->size() == limit) return res;
+
+            prev = curr + len;
+            curr = horspool
+                ? indexOf(sep, shifts, prev)
+                : indexOf(separator, prev);
         }
+        res->add(piece(prev, length_ - prev, share));
+        return res;
+    }
+
+    virtual JsArray::Ptr split(JsRegExp::Ptr separator, Size limit) const {
+        if (!separator) return split(CPtr(), limit, false);
+
+        return separator->split(toString(), limit);
+    }
+
+    virtual CPtr toLowerCase() const {
+        return convertCase('A', 'Z', 'a' - 'A');
+    }
+
+    virtual CPtr toUpperCase() const {
+        return convertCase('a', 'z', 'A' - 'a');
     }
 
     virtual Boolean isEmpty() const {
@@ -293,7 +421,7 @@ class String : public libj::String {
         } else if (from == 0) {
             return toString();
         } else {
-            return CPtr(new String(*this, from));
+            return slice(from, length_ - from);
         }
     }
 
@@ -304,110 +432,660 @@ class String : public libj::String {
         } else if (from == 0 && to == len) {
             return toString();
         } else {
-            return CPtr(new String(*this, from, to - from));
+            return slice(from, to - from);
         }
     }
 
     virtual CPtr replace(Char oldC, Char newC) const {
-        if (!str_.length()) return LIBJ_THIS_CPTR(String);
-
-        String* result = new String();
-        Size curr = 0;
-        Size prev = 0;
-        while ((curr = str_.find_first_of(oldC, curr)) != ustring::npos) {
-            result->str_.append(str_, prev, curr - prev);
-            result->str_ += newC;
-            curr++;
-            prev = curr;
+        Size pos = indexOf(oldC, 0);
+        if (pos == NO_POS) return LIBJ_THIS_CPTR(String);
+
+        String* s = new String();
+        if (oneByte_ && newC <= MAX_ONE_BYTE) {
+            UByte* d = static_cast<UByte*>(s->allocate(length_, true));
+            copyTo(d, 0, length_);
+            simd::replace(
+                d + pos,
+                length_ - pos,
+                static_cast<UByte>(oldC),
+                static_cast<UByte>(newC));
+        } else {
+            Char* d = static_cast<Char*>(s->allocate(length_, false));
+            copyTo(d, 0, length_);
+            simd::replace(d + pos, length_ - pos, oldC, newC);
         }
-        result->str_.append(str_, prev, str_.size() - prev);
-        return CPtr(result);
+        return CPtr(s);
     }
 
     virtual CPtr replace(CPtr oldS, CPtr newS) const {
-        if (!str_.length()) return LIBJ_THIS_CPTR(String);
+        if (!length_) return LIBJ_THIS_CPTR(String);
+
+        const String* oldp = LIBJ_DETAIL_STRING(oldS);
+        const String* newp = LIBJ_DETAIL_STRING(newS);
+        Size len = oldp->length_;
+        if (!len) return newS->concat(LIBJ_THIS_CPTR(String));
+
+        Size curr = indexOf(oldS, 0);
+        if (curr == NO_POS) return LIBJ_THIS_CPTR(String);
+
+        ShiftTable shifts;
+        Boolean horspool = len >= HORSPOOL_MIN_LENGTH;
+        if (horspool) shifts = oldp->shiftTable();
 
-        String* result = new String();
-        Size curr = 0;
+        ustring result;
         Size prev = 0;
-        const ustring* oldp = &LIBJ_INTERNAL_STRING(oldS);
-        const ustring* newp = &LIBJ_INTERNAL_STRING(newS);
-        Size len = oldp->size();
-        while ((curr = str_.find(*oldp, curr)) != ustring::npos) {
-            result->str_.append(str_, prev, curr - prev);
-            result->str_.append(*newp);
+        while (curr != NO_POS) {
+            appendTo(&result, prev, curr - prev);
+            newp->appendTo(&result, 0, newp->length_);
             curr += len;
             prev = curr;
+            curr = horspool
+                ? indexOf(oldp, shifts, curr)
+                : indexOf(oldS, curr);
         }
-        result->str_.append(str_, prev, str_.size() - prev);
-        return CPtr(result);
+        appendTo(&result, prev, length_ - prev);
+        return CPtr(new String(result));
     }
 
     virtual CPtr toString() const {
         return LIBJ_THIS_CPTR(String);
     }
 
+    // returns the null-terminated characters widened to Char.
+    // a one-byte string or a slice copies them once, on the first call.
     virtual const Char* data() const {
-        return str_.data();
+        if (!oneByte_ && !sliced_) return wides();
+
+#ifdef LIBJ_USE_THREAD
+        Char* w = wide_.load(LIBJ_DETAIL_MEMORY_ORDER(acquire));
+        if (!w) {
+            Char* nw = widen();
+            if (wide_.compare_exchange_strong(
+                    w, nw, LIBJ_DETAIL_MEMORY_ORDER(acq_rel))) {
+                w = nw;
+            } else {
+                delete[] nw;
+            }
+        }
+        return w;
+#else
+        if (!wide_) wide_ = widen();
+        return wide_;
+#endif
+    }
+
+#ifdef LIBJ_USE_UTF16
+
+    virtual std::string toStdString(Encoding enc) const {
+        if (oneByte_ && enc == UTF8) return toUtf8();
+        return glue::fromUtf16(toUString(), convertStrEncoding(enc));
+    }
+
+    virtual std::u16string toStdU16String() const {
+        return toUString();
+    }
+
+    virtual std::u32string toStdU32String() const {
+        return glue::utf16ToUtf32(toUString());
+    }
+
+#else  // LIBJ_USE_UTF16
+
+    virtual std::string toStdString(Encoding enc) const {
+        if (oneByte_ && enc == UTF8) return toUtf8();
+        return glue::fromUtf32(toUString(), convertStrEncoding(enc));
+    }
+
+    virtual std::u16string toStdU16String() const {
+        return glue::utf32ToUtf16(toUString());
+    }
+
+    virtual std::u32string toStdU32String() const {
+        return toUString();
+    }
+
+#endif  // LIBJ_USE_UTF16
+
+    void appendTo(ustring* s) const {
+        appendTo(s, 0, length_);
+    }
+
+    // calls (*f)(s, length) with the characters in either representation
+    template<typename F>
+    void visitChars(F* f) const {
+        if (oneByte_) {
+            (*f)(bytes(), length_);
+        } else {
+            (*f)(wides(), length_);
+        }
     }
 
  public:
-    static CPtr intern(CPtr str) {
+    static CPtr intern(CPtr str, Boolean weak) {
+        static SymbolTable<String>* symbols = new SymbolTable<String>();
+
+        if (!str || str->isInterned()) return str;
+
+        return symbols->intern(str, weak);
+    }
+
+    virtual Boolean isInterned() const {
+        return interned_;
+    }
+
+ private:
+    static const Char MAX_ONE_BYTE = 0xff;
+
+    static const Size CONS_MIN_LENGTH = 16;
+    static const Size SLICE_MIN_LENGTH = 32;
+    static const Size SLICE_MAX_RATIO = 4;
 #ifdef LIBJ_USE_THREAD
-        typedef ConcurrentMap SymbolMap;
+    static const Size NUM_MUTEXES = 64;
+#endif
+
+    struct Link {
+        Link(CPtr l, CPtr r) : left(l), right(r) {}
+
+        CPtr left;
+        CPtr right;
+    };
+
+    static CPtr createSymbol(CPtr str) {
+        String* s = new String(*LIBJ_DETAIL_STRING(str));
+        s->interned_ = true;
+        return CPtr(s);
+    }
+
+    void init() {
+        length_ = 0;
+        hash_ = 0;
+        oneByte_ = true;
+        interned_ = false;
+        sliced_ = false;
+        setChars(&inline_);
+        wide_ = NULL;
+        link_ = NULL;
+    }
+
+    // returns the null-terminated storage for len characters
+    void* allocate(Size len, Boolean oneByte) {
+        Size size = oneByte ? len + 1 : (len + 1) * sizeof(Char);
+        void* c = &inline_;
+        if (size > sizeof(inline_)) {
+            c = new UByte[size];
+        }
+        length_ = len;
+        oneByte_ = oneByte;
+        if (oneByte) {
+            static_cast<UByte*>(c)[len] = 0;
+        } else {
+            static_cast<Char*>(c)[len] = 0;
+        }
+        setChars(c);
+        return c;
+    }
+
+    void setChars(void* c) const {
+#ifdef LIBJ_USE_THREAD
+        chars_.store(c, LIBJ_DETAIL_MEMORY_ORDER(release));
+#else
+        chars_ = c;
+#endif
+    }
+
+    // returns NULL if this is an unflattened cons string
+    const void* peekChars() const {
+#ifdef LIBJ_USE_THREAD
+        return chars_.load(LIBJ_DETAIL_MEMORY_ORDER(acquire));
+#else
+        return chars_;
+#endif
+    }
+
+    const void* chars() const {
+        const void* c = peekChars();
+        return c ? c : flatten();
+    }
+
+    const void* flatten() const {
+        Size size = oneByte_ ? length_ + 1 : (length_ + 1) * sizeof(Char);
+        UByte* c = new UByte[size];
+        Boolean flattened = oneByte_
+            ? flattenTo(c)
+            : flattenTo(reinterpret_cast<Char*>(c));
+        if (!flattened) {
+            delete[] c;
+            return peekChars();
+        }
+
+#ifdef LIBJ_USE_THREAD
+        // another thread may be flattening this string at the same time
+        void* expected = NULL;
+        if (!chars_.compare_exchange_strong(
+                expected, c, LIBJ_DETAIL_MEMORY_ORDER(acq_rel))) {
+            delete[] c;
+            return expected;
+        }
 #else
-        typedef Map SymbolMap;
+        chars_ = c;
 #endif
-        static SymbolMap::Ptr symbols = SymbolMap::null();
-        if (!symbols) {
-            symbols = SymbolMap::create();
-            LIBJ_DEBUG_PRINT(
-                "static: SymbolMap %p",
-                LIBJ_DEBUG_OBJECT_PTR(symbols));
+        release(takeOwnLink());
+        return c;
+    }
+
+    // copies the flat strings in the tree in order, without recursion.
+    // returns false if the operands of this string are already released,
+    // which happens only after its characters are set.
+    template<typename C>
+    Boolean flattenTo(C* d) const {
+        std::vector<CPtr> nodes;
+        if (!pushOperands(&nodes)) return false;
+
+        while (!nodes.empty()) {
+            CPtr node;
+            std::swap(node, nodes.back());
+            nodes.pop_back();
+            const String* s = LIBJ_DETAIL_STRING(node);
+            if (s->peekChars() || !s->pushOperands(&nodes)) {
+                s->copyTo(d, 0, s->length_);
+                d += s->length_;
+            }
         }
+        *d = 0;
+        return true;
+    }
 
-        if (!str || str->isInterned()) return str;
+    // the nodes hold the operands, so that they stay alive
+    // while another thread flattens this string and releases them
+    Boolean pushOperands(std::vector<CPtr>* nodes) const {
+#ifdef LIBJ_USE_THREAD
+        ScopedLock lock(mutexOf(this));
+#endif
+        if (!link_) return false;
+
+        nodes->push_back(link_->right);
+        nodes->push_back(link_->left);
+        return true;
+    }
 
-        CPtr sym = toCPtr<libj::String>(symbols->get(str));
-        if (sym) {
-            return sym;
+    Link* takeOwnLink() const {
+#ifdef LIBJ_USE_THREAD
+        ScopedLock lock(mutexOf(this));
+#endif
+        Link* l = link_;
+        link_ = NULL;
+        return l;
+    }
+
+#ifdef LIBJ_USE_THREAD
+    // guards link_ of the cons strings that are being flattened
+    static Mutex& mutexOf(const String* s) {
+        static Mutex* mutexes = new Mutex[NUM_MUTEXES];
+        return mutexes[(reinterpret_cast<Size>(s) >> 4) % NUM_MUTEXES];
+    }
+#endif
+
+    Size peekHash() const {
+#ifdef LIBJ_USE_THREAD
+        return hash_.load(LIBJ_DETAIL_MEMORY_ORDER(relaxed));
+#else
+        return hash_;
+#endif
+    }
+
+    // FNV-1a over the character values, never zero
+    template<typename C>
+    UInt hash(const C* s) const {
+        UInt h = 2166136261U;
+        for (Size i = 0; i < length_; i++) {
+            h = (h ^ static_cast<UInt>(s[i])) * 16777619U;
+        }
+        return h ? h : 1;
+    }
+
+    // a slice is not created if it would keep alive
+    // a parent much longer than itself, unless share is true.
+    // the characters short enough to be stored inline are always copied.
+    CPtr slice(Size pos, Size count, Boolean share = false) const {
+        const String* root = sliced_ ? LIBJ_DETAIL_STRING(link_->left) : this;
+        Size width = oneByte_ ? 1 : sizeof(Char);
+        Boolean copied = share
+            ? (count + 1) * width <= sizeof(inline_)
+            : count < SLICE_MIN_LENGTH ||
+              count < root->length_ / SLICE_MAX_RATIO;
+        if (copied) return CPtr(new String(*this, pos, count));
+
+        const UByte* c = static_cast<const UByte*>(chars());
+        String* s = new String();
+        s->length_ = count;
+        s->oneByte_ = oneByte_;
+        s->sliced_ = true;
+        s->setChars(const_cast<UByte*>(c) + pos * width);
+        s->link_ = new Link(sliced_ ? link_->left : toString(), CPtr());
+        return CPtr(s);
+    }
+
+    // a piece of split
+    CPtr piece(Size pos, Size count, Boolean share) const {
+        if (!count) {
+            return libj::String::create();
+        } else if (count == length_) {
+            return toString();
         } else {
-            String* s = new String(*LIBJ_DETAIL_STRING(str));
-            s->interned_ = true;
+            return slice(pos, count, share);
+        }
+    }
 
-            CPtr sp(s);
-            symbols->put(sp, sp);
-            LIBJ_DEBUG_PRINT(
-                "symbol: [%d: %s] %p",
-                symbols->size(),
-                sp->toStdString().c_str(),
-                LIBJ_DEBUG_OBJECT_PTR(sp));
-            return sp;
+    // releases a long chain of cons strings without recursion,
+    // taking over the links of the operands that only it refers to
+    static void release(Link* link) {
+        std::vector<Link*> links;
+        links.push_back(link);
+        while (!links.empty()) {
+            Link* l = links.back();
+            links.pop_back();
+            if (!l) continue;
+
+            links.push_back(takeLink(l->left));
+            links.push_back(takeLink(l->right));
+            delete l;
         }
     }
 
-    virtual Boolean isInterned() const {
-        return interned_;
+    static Link* takeLink(const CPtr& p) {
+        if (!p || !isUnique(p)) return NULL;
+
+        const String* s = LIBJ_DETAIL_STRING(p);
+        Link* l = s->link_;
+        s->link_ = NULL;
+        return l;
     }
 
- private:
+    friend class SymbolTable<String>;
+
+    template<typename I>
+    friend class StringBuilder;
+
+    static Boolean isUnique(const CPtr& p) {
+#if defined(LIBJ_USE_INTRUSIVE_PTR)
+        return p->useCount() == 1;
+#elif defined(LIBJ_USE_SP)
+        return p.use_count() == 1;
+#else
+        return false;
+#endif
+    }
+
+    void assign(const Char* s, Size len) {
+        Boolean oneByte = true;
+        for (Size i = 0; i < len; i++) {
+            if (s[i] > MAX_ONE_BYTE) {
+                oneByte = false;
+                break;
+            }
+        }
+
+        if (oneByte) {
+            assignOneByte(s, len);
+        } else {
+            memcpy(allocate(len, false), s, len * sizeof(Char));
+        }
+    }
+
+    // narrows the characters, which all fit in one byte
+    void assignOneByte(const Char* s, Size len) {
+        UByte* d = static_cast<UByte*>(allocate(len, true));
+        for (Size i = 0; i < len; i++) {
+            d[i] = static_cast<UByte>(s[i]);
+        }
+    }
+
+    // takes over the null-terminated characters allocated as UByte[].
+    // some of them do not fit in one byte.
+    void adopt(Char* c, Size len) {
+        length_ = len;
+        oneByte_ = false;
+        setChars(c);
+    }
+
+    // ASCII needs no decoding
+    Boolean assignAscii(const char* s, Size len, Size max) {
+        Size n = len < max ? len : max;
+        Size i = 0;
+        for (; i < n && s[i]; i++) {
+            if (s[i] & 0x80) return false;
+        }
+        memcpy(allocate(i, true), s, i);
+        return true;
+    }
+
+    void copy(const String& other, Size pos, Size count) {
+        if (other.oneByte_) {
+            UByte* d = static_cast<UByte*>(allocate(count, true));
+            other.copyTo(d, pos, count);
+        } else {
+            Char* d = static_cast<Char*>(allocate(count, false));
+            other.copyTo(d, pos, count);
+        }
+    }
+
+    const UByte* bytes() const {
+        assert(oneByte_);
+        return static_cast<const UByte*>(chars());
+    }
+
+    const Char* wides() const {
+        assert(!oneByte_);
+        return static_cast<const Char*>(chars());
+    }
+
+    template<typename C>
+    void copyTo(C* d, Size pos, Size count) const {
+        if (oneByte_) {
+            copyChars(d, bytes() + pos, count);
+        } else {
+            copyChars(d, wides() + pos, count);
+        }
+    }
+
+    static void copyChars(UByte* d, const UByte* s, Size n) {
+        memcpy(d, s, n);
+    }
+
+    static void copyChars(Char* d, const Char* s, Size n) {
+        memcpy(d, s, n * sizeof(Char));
+    }
+
+    template<typename C1, typename C2>
+    static void copyChars(C1* d, const C2* s, Size n) {
+        for (Size i = 0; i < n; i++) {
+            assert(sizeof(C1) > sizeof(C2) || s[i] <= MAX_ONE_BYTE);
+            d[i] = static_cast<C1>(s[i]);
+        }
+    }
+
+    void appendTo(ustring* s, Size pos, Size count) const {
+        if (oneByte_) {
+            const UByte* b = bytes() + pos;
+            s->append(b, b + count);
+        } else {
+            s->append(wides() + pos, count);
+        }
+    }
+
+    ustring toUString() const {
+        if (oneByte_) {
+            return ustring(bytes(), bytes() + length_);
+        } else {
+            return ustring(wides(), length_);
+        }
+    }
+
+    std::string toUtf8() const {
+        const UByte* s = bytes();
+        std::string u8;
+        u8.reserve(length_);
+        for (Size i = 0; i < length_; i++) {
+            UByte c = s[i];
+            if (c < 0x80) {
+                u8 += static_cast<char>(c);
+            } else {
+                u8 += static_cast<char>(0xc0 | (c >> 6));
+                u8 += static_cast<char>(0x80 | (c & 0x3f));
+            }
+        }
+        return u8;
+    }
+
+    Char* widen() const {
+        Char* w = new Char[length_ + 1];
+        copyTo(w, 0, length_);
+        w[length_] = 0;
+        return w;
+    }
+
+    // first and last are ASCII
+    CPtr convertCase(Char first, Char last, Int diff) const {
+        UByte lo = static_cast<UByte>(first);
+        UByte hi = static_cast<UByte>(last);
+        Size pos = oneByte_
+            ? simd::findRange(bytes(), length_, lo, hi)
+            : simd::findRange(wides(), length_, first, last);
+        if (pos == NO_POS) return toString();
+
+        String* s = new String();
+        if (oneByte_) {
+            UByte* d = static_cast<UByte*>(s->allocate(length_, true));
+            copyTo(d, 0, length_);
+            simd::shiftRange(d + pos, length_ - pos, lo, hi, diff);
+        } else {
+            Char* d = static_cast<Char*>(s->allocate(length_, false));
+            copyTo(d, 0, length_);
+            simd::shiftRange(d + pos, length_ - pos, first, last, diff);
+        }
+        return CPtr(s);
+    }
+
+    // calls op with the characters of s1 and s2 in their representations
+    template<typename Op>
+    static typename Op::Result dispatch(
+        const String* s1, const String* s2, const Op& op) {
+        if (s1->oneByte_) {
+            if (s2->oneByte_) {
+                return op(s1->bytes(), s2->bytes());
+            } else {
+                return op(s1->bytes(), s2->wides());
+            }
+        } else {
+            if (s2->oneByte_) {
+                return op(s1->wides(), s2->bytes());
+            } else {
+                return op(s1->wides(), s2->wides());
+            }
+        }
+    }
+
+    // compares s1[pos, pos + n1) with s2[0, n2)
+    class Compare {
+     public:
+        typedef Int Result;
+
+        Compare(Size pos, Size n1, Size n2)
+            : pos_(pos), n1_(n1), n2_(n2) {}
+
+        template<typename C1, typename C2>
+        Int operator()(const C1* s1, const C2* s2) const {
+            s1 += pos_;
+            Size n = n1_ < n2_ ? n1_ : n2_;
+            for (Size i = 0; i < n; i++) {
+                if (s1[i] != s2[i]) {
+                    return static_cast<Char>(s1[i]) < static_cast<Char>(s2[i])
+                        ? -1 : 1;
+                }
+            }
+            return n1_ == n2_ ? 0 : n1_ < n2_ ? -1 : 1;
+        }
+
+     private:
+        Size pos_;
+        Size n1_;
+        Size n2_;
+    };
+
+    // finds the first s2[0, n2) in s1[from, n1).
+    // a long s2 is searched for by Boyer-Moore-Horspool,
+    // using shifts if given, and a short one by searchByPair.
+    class Find {
+     public:
+        typedef Size Result;
+
+        Find(Size n1, Size n2, Size from, const ShiftTable* shifts = NULL)
+            : n1_(n1), n2_(n2), from_(from), shifts_(shifts) {}
+
+        template<typename C1, typename C2>
+        Size operator()(const C1* s1, const C2* s2) const {
+            if (from_ > n1_ || n2_ > n1_ - from_) return NO_POS;
+            if (!n2_) return from_;
+
+            if (shifts_) {
+                return searchByHorspool(s1, n1_, s2, n2_, from_, *shifts_);
+            } else if (n2_ >= HORSPOOL_MIN_LENGTH) {
+                ShiftTable shifts(s2, n2_);
+                return searchByHorspool(s1, n1_, s2, n2_, from_, shifts);
+            } else {
+                return searchByPair(s1, n1_, s2, n2_, from_);
+            }
+        }
+
+     private:
+        Size n1_;
+        Size n2_;
+        Size from_;
+        const ShiftTable* shifts_;
+    };
+
+    // finds the last s2[0, n2) in s1 starting at or before from
+    class RFind {
+     public:
+        typedef Size Result;
+
+        RFind(Size n1, Size n2, Size from)
+            : n1_(n1), n2_(n2), from_(from) {}
+
+        template<typename C1, typename C2>
+        Size operator()(const C1* s1, const C2* s2) const {
+            if (n2_ > n1_) return NO_POS;
+
+            Size i = n1_ - n2_;
+            if (from_ < i) i = from_;
+            do {
+                Size j = 0;
+                while (j < n2_ && s1[i + j] == s2[j]) j++;
+                if (j == n2_) return i;
+            } while (i-- > 0);
+            return NO_POS;
+        }
+
+     private:
+        Size n1_;
+        Size n2_;
+        Size from_;
+    };
+
     class CharIterator : public Iterator {
         friend class String;
-        typedef ustring::const_iterator CItr;
 
      public:
         virtual Boolean hasNext() const {
-            return pos_ != end_;
+            return pos_ != str_->length_;
         }
 
         virtual Char nextTyped() {
-            if (pos_ == end_) {
+            if (pos_ == str_->length_) {
                 LIBJ_THROW(Error::NO_SUCH_ELEMENT);
                 return 0;
             } else {
-                Char c = *pos_;
-                ++pos_;
-                return c;
+                return str_->charAt(pos_++);
             }
         }
 
@@ -416,24 +1094,43 @@ class String : public libj::String {
         }
 
      private:
-        CItr pos_;
-        CItr end_;
+        const String* str_;
+        Size pos_;
 
-        CharIterator(const ustring& str)
-            : pos_(str.begin())
-            , end_(str.end()) {}
+        CharIterator(const String* str)
+            : str_(str)
+            , pos_(0) {}
 
         CharIterator(const CharIterator* itr)
-            : pos_(itr->pos_)
-            , end_(itr->end_) {}
+            : str_(itr->str_)
+            , pos_(itr->pos_) {}
     };
 
  private:
-    ustring str_;
+    Size length_;
+#ifdef LIBJ_USE_THREAD
+    mutable LIBJ_DETAIL_ATOMIC(UInt) hash_;
+#else
+    mutable UInt hash_;
+#endif
+    Boolean oneByte_;
     Boolean interned_;
+    Boolean sliced_;
+#ifdef LIBJ_USE_THREAD
+    mutable LIBJ_DETAIL_ATOMIC(void*) chars_;
+    mutable LIBJ_DETAIL_ATOMIC(Char*) wide_;
+#else
+    mutable void* chars_;
+    mutable Char* wide_;
+#endif
+    // the operands of a cons string, or the parent of a slice in left
+    mutable Link* link_;
+    union {
+        UByte bytes[16];
+        Char chars[16 / sizeof(Char)];
+    } inline_;
 };
 
-#undef LIBJ_INTERNAL_STRING
 #undef LIBJ_DETAIL_STRING
 
 }  // namespace detail
@@ -17,6 +17,16 @@ class StringBuffer : public StringBuilder<libj::StringBuffer> {
         return StringBuilder::length();
     }
 
+    virtual Size capacity() const {
+        ScopedLock lock(mutex_);
+        return StringBuilder::capacity();
+    }
+
+    virtual void reserve(Size capacity) {
+        ScopedLock lock(mutex_);
+        StringBuilder::reserve(capacity);
+    }
+
     virtual Char charAt(Size index) const {
         ScopedLock lock(mutex_);
         return StringBuilder::charAt(index);
@@ -47,6 +57,12 @@ class StringBuffer : public StringBuilder<libj::StringBuffer> {
         return StringBuilder::appendStr(str);
     }
 
+    virtual Ptr appendUtf8(
+        glue::Utf8Decoder* decoder, const void* data, Size len) {
+        ScopedLock lock(mutex_);
+        return StringBuilder::appendUtf8(decoder, data, len);
+    }
+
     virtual Boolean setCharAt(Size index, Char c) {
         ScopedLock lock(mutex_);
         return StringBuilder::setCharAt(index, c);
@@ -62,6 +78,11 @@ class StringBuffer : public StringBuilder<libj::StringBuffer> {
         return StringBuilder::data();
     }
 
+    virtual String::CPtr build() {
+        ScopedLock lock(mutex_);
+        return StringBuilder::build();
+    }
+
  private:
     mutable Mutex mutex_;
 };
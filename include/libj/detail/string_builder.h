@@ -5,25 +5,50 @@
 
 #include <libj/this.h>
 #include <libj/symbol.h>
+#include <libj/detail/simd.h>
+#include <libj/detail/string.h>
 #include <libj/detail/to_string.h>
+#include <libj/glue/cvtutf.h>
 
 #include <assert.h>
+#include <string.h>
 
 namespace libj {
 namespace detail {
 
+// the characters are stored in the same null-terminated buffer as
+// the ones of String, so that build() can hand it over without copying.
+// whether they all fit in one byte is tracked conservatively.
 template<typename I>
 class StringBuilder : public I {
  public:
     typedef typename I::Ptr Ptr;
     typedef typename I::CPtr CPtr;
 
+    StringBuilder()
+        : buf_(NULL)
+        , length_(0)
+        , capacity_(0)
+        , oneByte_(true) {}
+
+    virtual ~StringBuilder() {
+        release(buf_);
+    }
+
     virtual Size length() const {
-        return buf_.length();
+        return length_;
+    }
+
+    virtual Size capacity() const {
+        return capacity_;
+    }
+
+    virtual void reserve(Size capacity) {
+        if (capacity > capacity_) release(expand(capacity));
     }
 
     virtual Char charAt(Size index) const {
-        if (index >= buf_.length()) {
+        if (index >= length_) {
             return NO_CHAR;
         } else {
             return buf_[index];
@@ -39,42 +64,41 @@ class StringBuilder : public I {
         if (val.isObject()) {
             String::CPtr s = toCPtr<Object>(val)->toString();
             assert(s);
-            buf_.append(s->data());
+            appendString(s);
         } else if (val.isPrimitive()) {
             if (val.is<Boolean>()) {
                 if (to<Boolean>(val)) {
-                    buf_.append(symTrue->data());
+                    appendString(symTrue);
                 } else {
-                    buf_.append(symFalse->data());
+                    appendString(symFalse);
                 }
             } else if (val.is<Double>()) {
-                const Size kLen = 64;
-                char buf[kLen];
-                doubleToString(val, buf, kLen);
-                return StringBuilder::appendStr(buf);
+                release(prepare(MAX_NUMBER_LENGTH));
+                length_ += formatDouble(to<Double>(val), buf_ + length_);
+                buf_[length_] = 0;
             } else if (val.is<Float>()) {
-                const Size kLen = 64;
-                char buf[kLen];
-                floatToString(val, buf, kLen);
-                return StringBuilder::appendStr(buf);
+                release(prepare(MAX_NUMBER_LENGTH));
+                length_ += formatDouble(to<Float>(val), buf_ + length_);
+                buf_[length_] = 0;
             } else {
-                const Size kLen = 64;
-                Char buf[kLen];
-                const Char* s = integerToString(val, buf, kLen);
-                assert(s);
-                buf_.append(s);
+                release(prepare(MAX_INTEGER_LENGTH));
+                length_ += formatInteger(val, buf_ + length_);
+                buf_[length_] = 0;
             }
         } else if (val.isNull()) {
-            buf_.append(symNull->data());
+            appendString(symNull);
         } else {
             assert(val.isUndefined());
-            buf_.append(symUndefined->data());
+            appendString(symUndefined);
         }
         return LIBJ_THIS_PTR(I);
     }
 
     virtual Ptr appendChar(Char c) {
-        buf_.push_back(c);
+        release(prepare(1));
+        if (c > MAX_ONE_BYTE) oneByte_ = false;
+        buf_[length_++] = c;
+        buf_[length_] = 0;
         return LIBJ_THIS_PTR(I);
     }
 
@@ -82,11 +106,22 @@ class StringBuilder : public I {
         LIBJ_STATIC_SYMBOL_DEF(symNull, "null");
 
         if (str) {
-            while (Char c = static_cast<Char>(*str++)) {
-                buf_.push_back(c);
+            Size n = strlen(str);
+            release(prepare(n));
+
+            const UByte* s = reinterpret_cast<const UByte*>(str);
+            Char* d = buf_ + length_;
+            Size i = n < SIMD_MIN_LENGTH ? 0 : simd::widenAscii(s, n, d);
+            UByte bits = 0;
+            for (; i < n; i++) {
+                bits |= s[i];
+                d[i] = static_cast<Char>(str[i]);
             }
+            if (bits & 0x80) oneByte_ = false;
+            length_ += n;
+            buf_[length_] = 0;
         } else {
-            buf_.append(symNull->data());
+            appendString(symNull);
         }
         return LIBJ_THIS_PTR(I);
     }
@@ -95,9 +130,11 @@ class StringBuilder : public I {
         LIBJ_STATIC_SYMBOL_DEF(symNull, "null");
 
         if (str) {
-            buf_.append(str);
+            Size n = 0;
+            while (str[n]) n++;
+            appendChars(str, n);
         } else {
-            buf_.append(symNull->data());
+            appendString(symNull);
         }
         return LIBJ_THIS_PTR(I);
     }
@@ -106,36 +143,157 @@ class StringBuilder : public I {
         LIBJ_STATIC_SYMBOL_DEF(symNull, "null");
 
         if (str) {
-            buf_.append(str->data());
+            appendString(str);
         } else {
-            buf_.append(symNull->data());
+            appendString(symNull);
+        }
+        return LIBJ_THIS_PTR(I);
+    }
+
+    virtual Ptr appendUtf8(
+        glue::Utf8Decoder* decoder, const void* data, Size len) {
+        assert(decoder);
+        if (data) {
+            release(prepare(len + 1));
+            Char* d = buf_ + length_;
+            Size n = decoder->decode(data, len, d);
+            checkOneByte(d, n);
+            length_ += n;
+            buf_[length_] = 0;
+        } else if (decoder->pending()) {
+            decoder->reset();
+            appendChar(REPLACEMENT_CHAR);
         }
         return LIBJ_THIS_PTR(I);
     }
 
     virtual Boolean setCharAt(Size index, Char c) {
-        if (index >= buf_.length()) {
+        if (index >= length_) {
             return false;
         } else {
+            if (c > MAX_ONE_BYTE) oneByte_ = false;
             buf_[index] = c;
             return true;
         }
     }
 
     virtual String::CPtr toString() const {
-        return String::create(buf_);
+        if (!length_) return String::create();
+
+        String* s = new String();
+        if (oneByte_) {
+            s->assignOneByte(buf_, length_);
+        } else {
+            s->assign(buf_, length_);
+        }
+        return String::CPtr(s);
+    }
+
+    virtual String::CPtr build() {
+        // a short string is stored inline, and a buffer much larger than
+        // the string is kept for reuse rather than handed over.
+        // nor is a one-byte string, whose buffer would be sizeof(Char)
+        // times as large as its narrowed characters. it is narrowed
+        // into storage of its own size instead.
+        if (oneByte_ ||
+            length_ < MIN_HANDOVER_LENGTH ||
+            capacity_ / 2 > length_) {
+            String::CPtr s = toString();
+            length_ = 0;
+            oneByte_ = true;
+            if (buf_) buf_[0] = 0;
+            return s;
+        }
+
+        String* s = new String();
+        s->adopt(buf_, length_);
+        buf_ = NULL;
+        length_ = 0;
+        capacity_ = 0;
+        oneByte_ = true;
+        return String::CPtr(s);
     }
 
     virtual const Char* data() const {
-        return buf_.data();
+        static const Char empty = 0;
+        return buf_ ? buf_ : &empty;
     }
 
  private:
-#ifdef LIBJ_USE_UTF32
-    std::u32string buf_;
-#else
-    std::u16string buf_;
-#endif
+    static const Char MAX_ONE_BYTE = 0xff;
+    static const Char MAX_CHAR = static_cast<Char>(-1);
+    static const Char REPLACEMENT_CHAR = 0xfffd;
+    static const Size MIN_CAPACITY = 16;
+    static const Size MIN_HANDOVER_LENGTH = 16;
+    static const Size SIMD_MIN_LENGTH = 16;
+
+    // makes room for n more characters and returns the buffer replaced,
+    // which may still hold the characters being appended
+    Char* prepare(Size n) {
+        if (buf_ && length_ + n <= capacity_) return NULL;
+
+        return expand(length_ + n);
+    }
+
+    Char* expand(Size capacity) {
+        Size cap = capacity_ * 2;
+        if (cap < capacity) cap = capacity;
+        if (cap < MIN_CAPACITY) cap = MIN_CAPACITY;
+
+        Char* buf = reinterpret_cast<Char*>(
+            new UByte[(cap + 1) * sizeof(Char)]);
+        if (buf_) {
+            memcpy(buf, buf_, (length_ + 1) * sizeof(Char));
+        } else {
+            buf[0] = 0;
+        }
+
+        Char* old = buf_;
+        buf_ = buf;
+        capacity_ = cap;
+        return old;
+    }
+
+    static void release(Char* buf) {
+        delete[] reinterpret_cast<UByte*>(buf);
+    }
+
+    void checkOneByte(const Char* s, Size n) {
+        if (!oneByte_) return;
+
+        if (n < SIMD_MIN_LENGTH) {
+            for (Size i = 0; i < n; i++) {
+                if (s[i] > MAX_ONE_BYTE) oneByte_ = false;
+            }
+        } else if (simd::findRange(
+                s, n, MAX_ONE_BYTE + 1, MAX_CHAR) != NO_POS) {
+            oneByte_ = false;
+        }
+    }
+
+    void appendChars(const Char* s, Size n) {
+        Char* old = prepare(n);
+        memcpy(buf_ + length_, s, n * sizeof(Char));
+        checkOneByte(s, n);
+        length_ += n;
+        buf_[length_] = 0;
+        release(old);
+    }
+
+    void appendString(String::CPtr str) {
+        const String* s = static_cast<const String*>(&(*str));
+        Size n = s->length_;
+        release(prepare(n));
+        s->copyTo(buf_ + length_, 0, n);
+        if (!s->oneByte_) checkOneByte(buf_ + length_, n);
+        length_ += n;
+        buf_[length_] = 0;
+    }
+
+    Char* buf_;
+    Size length_;
+    Size capacity_;
+    Boolean oneByte_;
 };
 
 }  // namespace detail
@@ -0,0 +1,108 @@
+// Copyright (c) 2013 Plenluno All rights reserved.
+
+#ifndef LIBJ_DETAIL_STRING_SEARCH_H_
+#define LIBJ_DETAIL_STRING_SEARCH_H_
+
+#include <libj/constant.h>
+#include <libj/detail/simd.h>
+
+#include <string.h>
+
+namespace libj {
+namespace detail {
+
+// the bad character shifts of the Boyer-Moore-Horspool algorithm.
+// characters are indexed by their low byte, and the shifts are capped,
+// so that the table stays small. both only make the shifts shorter.
+class ShiftTable {
+ public:
+    static const Size MAX_SHIFT = 255;
+
+    ShiftTable() {
+        memset(shifts_, 0, sizeof(shifts_));
+    }
+
+    template<typename C>
+    ShiftTable(const C* p, Size m) {
+        Size last = m ? m - 1 : 0;
+        Size def = m;
+        if (def > MAX_SHIFT) def = MAX_SHIFT;
+        memset(shifts_, static_cast<int>(def), sizeof(shifts_));
+        for (Size i = last > MAX_SHIFT ? last - MAX_SHIFT : 0; i < last; i++) {
+            shifts_[static_cast<UByte>(p[i])] = static_cast<UByte>(last - i);
+        }
+    }
+
+    Size operator[](Char c) const {
+        return shifts_[static_cast<UByte>(c)];
+    }
+
+ private:
+    UByte shifts_[256];
+};
+
+// patterns shorter than this are searched for by their first and last
+// characters, which SIMD finds faster than Horspool skips over them
+static const Size HORSPOOL_MIN_LENGTH = 256;
+
+inline Size findPair(const UByte* s, Size n, Char first, Char last, Size gap) {
+    if (first > 0xff || last > 0xff) return NO_POS;
+
+    return simd::findPair(
+        s, n, static_cast<UByte>(first), static_cast<UByte>(last), gap);
+}
+
+inline Size findPair(const Char* s, Size n, Char first, Char last, Size gap) {
+    return simd::findPair(s, n, first, last, gap);
+}
+
+template<typename C1, typename C2>
+inline Boolean matchChars(const C1* s1, const C2* s2, Size n) {
+    for (Size i = 0; i < n; i++) {
+        if (s1[i] != s2[i]) return false;
+    }
+    return true;
+}
+
+// finds the first p[0, m) in s[from, n), where 0 < m,
+// checking only the positions of its first and last characters
+template<typename C1, typename C2>
+inline Size searchByPair(
+    const C1* s, Size n, const C2* p, Size m, Size from) {
+    if (from > n || m > n - from) return NO_POS;
+
+    Size gap = m - 1;
+    Size end = n - gap;
+    Size i = from;
+    while (i < end) {
+        Size j = findPair(s + i, end - i, p[0], p[gap], gap);
+        if (j == NO_POS) return NO_POS;
+
+        i += j;
+        if (matchChars(s + i + 1, p + 1, gap)) return i;
+        i++;
+    }
+    return NO_POS;
+}
+
+// finds the first p[0, m) in s[from, n), where 0 < m
+template<typename C1, typename C2>
+inline Size searchByHorspool(
+    const C1* s, Size n, const C2* p, Size m, Size from,
+    const ShiftTable& shifts) {
+    if (from > n || m > n - from) return NO_POS;
+
+    Size last = m - 1;
+    Char pl = p[last];
+    for (Size i = from; i <= n - m;) {
+        Char c = s[i + last];
+        if (c == pl && matchChars(s + i, p, last)) return i;
+        i += shifts[c];
+    }
+    return NO_POS;
+}
+
+}  // namespace detail
+}  // namespace libj
+
+#endif  // LIBJ_DETAIL_STRING_SEARCH_H_
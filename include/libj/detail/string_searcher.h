@@ -0,0 +1,49 @@
+// Copyright (c) 2013 Plenluno All rights reserved.
+
+#ifndef LIBJ_DETAIL_STRING_SEARCHER_H_
+#define LIBJ_DETAIL_STRING_SEARCHER_H_
+
+#include <libj/constant.h>
+#include <libj/detail/string.h>
+
+namespace libj {
+namespace detail {
+
+template<typename I>
+class StringSearcher : public I {
+ public:
+    StringSearcher(libj::String::CPtr pattern)
+        : pattern_(pattern)
+        , shifts_(toDetail(pattern)->shiftTable()) {}
+
+    virtual libj::String::CPtr pattern() const {
+        return pattern_;
+    }
+
+    virtual Size search(libj::String::CPtr str, Size from) const {
+        if (!str) return NO_POS;
+
+        if (pattern_->length() < HORSPOOL_MIN_LENGTH) {
+            return str->indexOf(pattern_, from);
+        } else {
+            return toDetail(str)->indexOf(toDetail(pattern_), shifts_, from);
+        }
+    }
+
+    virtual libj::String::CPtr toString() const {
+        return pattern_;
+    }
+
+ private:
+    libj::String::CPtr pattern_;
+    ShiftTable shifts_;
+
+    static const String* toDetail(libj::String::CPtr s) {
+        return static_cast<const String*>(&(*s));
+    }
+};
+
+}  // namespace detail
+}  // namespace libj
+
+#endif  // LIBJ_DETAIL_STRING_SEARCHER_H_
@@ -0,0 +1,130 @@
+// Copyright (c) 2013 Plenluno All rights reserved.
+
+#ifndef LIBJ_DETAIL_SYMBOL_TABLE_H_
+#define LIBJ_DETAIL_SYMBOL_TABLE_H_
+
+#include <libj/debug_print.h>
+#include <libj/detail/noncopyable.h>
+
+#ifdef LIBJ_USE_THREAD
+# include <libj/detail/scoped_lock.h>
+#endif
+
+#ifdef LIBJ_USE_CXX11
+# include <unordered_map>
+#else
+# include <boost/unordered_map.hpp>
+#endif
+
+#include <utility>
+
+namespace libj {
+namespace detail {
+
+// the table of interned strings, split into shards by hash code
+// so that threads interning different strings rarely contend.
+//
+// a weak symbol is removed once the table holds the only reference
+// to it. each shard is swept when it has doubled since the last sweep.
+template<typename S>
+class SymbolTable : private NonCopyable {
+ public:
+    typedef typename S::CPtr CPtr;
+
+    CPtr intern(CPtr str, Boolean weak) {
+        Shard& shard = shards_[index(str->hashCode())];
+#ifdef LIBJ_USE_THREAD
+        ScopedLock lock(shard.mutex);
+#endif
+
+        Itr itr = shard.symbols.find(str);
+        if (itr != shard.symbols.end()) {
+            if (!weak) itr->second = false;
+            return itr->first;
+        }
+
+        if (shard.symbols.size() >= shard.threshold) sweep(&shard);
+
+        CPtr sym = S::createSymbol(str);
+        shard.symbols.insert(std::make_pair(sym, weak));
+        LIBJ_DEBUG_PRINT(
+            "symbol: [%d: %s] %p",
+            shard.symbols.size(),
+            sym->toStdString().c_str(),
+            LIBJ_DEBUG_OBJECT_PTR(sym));
+        return sym;
+    }
+
+    Size size() {
+        Size n = 0;
+        for (Size i = 0; i < NUM_SHARDS; i++) {
+#ifdef LIBJ_USE_THREAD
+            ScopedLock lock(shards_[i].mutex);
+#endif
+            n += shards_[i].symbols.size();
+        }
+        return n;
+    }
+
+ private:
+    static const Size NUM_SHARDS = 16;
+    static const Size MIN_THRESHOLD = 64;
+
+    struct Hash {
+        Size operator()(const CPtr& s) const {
+            return s->hashCode();
+        }
+    };
+
+    struct Equal {
+        Boolean operator()(const CPtr& s1, const CPtr& s2) const {
+            return s1->equals(s2);
+        }
+    };
+
+    // maps each symbol to whether it is weak
+#ifdef LIBJ_USE_CXX11
+    typedef std::unordered_map<CPtr, Boolean, Hash, Equal> Symbols;
+#else
+    typedef boost::unordered_map<CPtr, Boolean, Hash, Equal> Symbols;
+#endif
+    typedef typename Symbols::iterator Itr;
+
+    struct Shard {
+        Shard() : threshold(MIN_THRESHOLD) {}
+
+#ifdef LIBJ_USE_THREAD
+        Mutex mutex;
+#endif
+        Symbols symbols;
+        Size threshold;
+    };
+
+    // the low bits are left to the buckets of each shard
+    static Size index(Size hash) {
+        return (hash >> 24) % NUM_SHARDS;
+    }
+
+    // nobody else can obtain a symbol held only by the table,
+    // since the shard is locked
+    static void sweep(Shard* shard) {
+        Symbols& symbols = shard->symbols;
+        for (Itr itr = symbols.begin(); itr != symbols.end();) {
+            if (itr->second && S::isUnique(itr->first)) {
+                itr = symbols.erase(itr);
+            } else {
+                ++itr;
+            }
+        }
+
+        Size n = symbols.size() * 2;
+        shard->threshold = n > MIN_THRESHOLD ? n : MIN_THRESHOLD;
+    }
+
+    Shard shards_[NUM_SHARDS];
+};
+
+}  // namespace detail
+}  // namespace libj
+
+#endif  // LIBJ_DETAIL_SYMBOL_TABLE_H_
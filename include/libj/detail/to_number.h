@@ -0,0 +1,33 @@
+// Copyright (c) 2013 Plenluno All rights reserved.
+
+#ifndef LIBJ_DETAIL_TO_NUMBER_H_
+#define LIBJ_DETAIL_TO_NUMBER_H_
+
+#include <libj/typedef.h>
+
+namespace libj {
+namespace detail {
+
+// the parsers of the characters of strings in either representation.
+// decimals are converted with correct rounding.
+
+Double parseInt(const UByte* s, Size n, Int radix);
+
+Double parseInt(const Char* s, Size n, Int radix);
+
+Double parseFloat(const UByte* s, Size n);
+
+Double parseFloat(const Char* s, Size n);
+
+Double toNumber(const UByte* s, Size n);
+
+Double toNumber(const Char* s, Size n);
+
+Boolean parseLong(const UByte* s, Size n, Long* out);
+
+Boolean parseLong(const Char* s, Size n, Long* out);
+
+}  // namespace detail
+}  // namespace libj
+
+#endif  // LIBJ_DETAIL_TO_NUMBER_H_
@@ -11,107 +11,205 @@
 namespace libj {
 namespace detail {
 
+// the longest integer is "-9223372036854775808"
+static const Size MAX_INTEGER_LENGTH = 20;
+
+// the numbers given by glue::dtoa are shorter than this
+static const Size MAX_NUMBER_LENGTH = 64;
+
+inline const char* hexits() {
+    static const char h[] = "0123456789abcdef";
+    return h;
+}
+
+inline const char* digitPairs() {
+    static const char p[] =
+        "00010203040506070809"
+        "10111213141516171819"
+        "20212223242526272829"
+        "30313233343536373839"
+        "40414243444546474849"
+        "50515253545556575859"
+        "60616263646566676869"
+        "70717273747576777879"
+        "80818283848586878889"
+        "90919293949596979899";
+    return p;
+}
+
+inline Size countDigits(ULong u) {
+    Size n = 1;
+    for (;;) {
+        if (u < 10) return n;
+        if (u < 100) return n + 1;
+        if (u < 1000) return n + 2;
+        if (u < 10000) return n + 3;
+        u /= 10000;
+        n += 4;
+    }
+}
+
+// writes the decimal digits of u backward from end, two at a time
+template<typename C>
+inline C* formatDecimal(ULong u, C* end) {
+    const char* pairs = digitPairs();
+    while (u >= 100) {
+        Size i = static_cast<Size>(u % 100) * 2;
+        u /= 100;
+        *--end = pairs[i + 1];
+        *--end = pairs[i];
+    }
+    if (u >= 10) {
+        Size i = static_cast<Size>(u) * 2;
+        *--end = pairs[i + 1];
+        *--end = pairs[i];
+    } else {
+        *--end = static_cast<C>('0' + u);
+    }
+    return end;
+}
+
 template<typename T>
 inline const Char* signedToString(T t, Char* buf, Size len, T radix = 10) {
-    LIBJ_STATIC_SYMBOL_DEF(symHexits, "0123456789abcdef");
-    static const Char* hexits = symHexits->data();
     assert(radix >= 2 && radix <= 16);
 
+    // negating the minimum of T overflows, but not in ULong
     Boolean sign = t < 0;
-    if (sign) t = -t;
+    ULong u = static_cast<ULong>(t);
+    if (sign) u = 0 - u;
 
     Char* cp = buf + len - 1;
-    *cp-- = 0;
-
-    do {
-        *cp-- = hexits[t % radix];
-        t /= radix;
-    } while (t > 0);
+    *cp = 0;
 
-    if (sign) {
-        *cp = '-';
-        return cp;
+    if (radix == 10) {
+        cp = formatDecimal(u, cp);
     } else {
-        return cp + 1;
+        const char* h = hexits();
+        ULong r = static_cast<ULong>(radix);
+        do {
+            *--cp = h[u % r];
+            u /= r;
+        } while (u > 0);
     }
+
+    if (sign) *--cp = '-';
+    return cp;
 }
 
 template<typename T>
 inline const Char* unsignedToString(T t, Char* buf, Size len, T radix = 10) {
-    LIBJ_STATIC_SYMBOL_DEF(symHexits, "0123456789abcdef");
-    static const Char* hexits = symHexits->data();
     assert(radix >= 2 && radix <= 16);
 
+    ULong u = static_cast<ULong>(t);
     Char* cp = buf + len - 1;
-    *cp-- = 0;
+    *cp = 0;
 
-    do {
-        *cp-- = hexits[t % radix];
-        t /= radix;
-    } while (t > 0);
+    if (radix == 10) {
+        return formatDecimal(u, cp);
+    } else {
+        const char* h = hexits();
+        ULong r = static_cast<ULong>(radix);
+        do {
+            *--cp = h[u % r];
+            u /= r;
+        } while (u > 0);
+        return cp;
+    }
+}
 
-    return cp + 1;
+// writes the decimal integer to d, which needs room for
+// MAX_INTEGER_LENGTH characters, and returns the number written
+template<typename C>
+inline Size formatInteger(ULong u, Boolean negative, C* d) {
+    Size n = countDigits(u);
+    if (negative) {
+        *d++ = '-';
+        formatDecimal(u, d + n);
+        return n + 1;
+    } else {
+        formatDecimal(u, d + n);
+        return n;
+    }
+}
+
+template<typename T, typename C>
+inline Size formatSigned(T t, C* d) {
+    ULong u = static_cast<ULong>(t);
+    return t < 0 ? formatInteger(0 - u, true, d) : formatInteger(u, false, d);
 }
 
-inline const Char* integerToString(const Value& val, Char* buf, Size len) {
+template<typename T, typename C>
+inline Size formatUnsigned(T t, C* d) {
+    return formatInteger(static_cast<ULong>(t), false, d);
+}
+
+template<typename C>
+inline Size formatInteger(const Value& val, C* d) {
     if (val.is<Int>()) {
-        return signedToString<Int>(to<Int>(val), buf, len);
+        return formatSigned(to<Int>(val), d);
     } else if (val.is<Long>()) {
-        return signedToString<Long>(to<Long>(val), buf, len);
+        return formatSigned(to<Long>(val), d);
     } else if (val.is<Size>()) {
-        return unsignedToString<Size>(to<Size>(val), buf, len);
+        return formatUnsigned(to<Size>(val), d);
     } else if (val.is<UInt>()) {
-        return unsignedToString<UInt>(to<UInt>(val), buf, len);
+        return formatUnsigned(to<UInt>(val), d);
     } else if (val.is<ULong>()) {
-        return unsignedToString<ULong>(to<ULong>(val), buf, len);
+        return formatUnsigned(to<ULong>(val), d);
     } else if (val.is<Byte>()) {
-        return signedToString<Byte>(to<Byte>(val), buf, len);
+        return formatSigned(to<Byte>(val), d);
     } else if (val.is<UByte>()) {
-        return unsignedToString<UByte>(to<UByte>(val), buf, len);
+        return formatUnsigned(to<UByte>(val), d);
     } else if (val.is<Short>()) {
-        return signedToString<Short>(to<Short>(val), buf, len);
+        return formatSigned(to<Short>(val), d);
     } else if (val.is<UShort>()) {
-        return unsignedToString<UShort>(to<UShort>(val), buf, len);
+        return formatUnsigned(to<UShort>(val), d);
     } else if (val.is<TypeId>()) {
-        return unsignedToString<TypeId>(to<TypeId>(val), buf, len);
+        return formatUnsigned(to<TypeId>(val), d);
     } else {
         assert(false);
-        return NULL;
+        return 0;
     }
 }
 
-inline String::CPtr integerToString(const Value& val) {
-    const Size kLen = 64;
-    Char buf[kLen];
-#ifdef LIBJ_USE_UTF32
-    return String::create(integerToString(val, buf, kLen), String::UTF32);
-#else
-    return String::create(integerToString(val, buf, kLen), String::UTF16);
-#endif
-}
+// writes the shortest decimal which reads back as d to out, which needs
+// room for MAX_NUMBER_LENGTH characters, and returns the number written.
+// the integers whose digits are all exact are formatted as such,
+// and the others by glue::dtoa.
+template<typename C>
+inline Size formatDouble(Double d, C* out) {
+    // 2^53
+    const Double kMaxExact = 9007199254740992.0;
+
+    if (d > -kMaxExact && d < kMaxExact) {
+        Long l = static_cast<Long>(d);
+        if (static_cast<Double>(l) == d) return formatSigned(l, out);
+    }
 
-inline void floatToString(const Value& val, char* buf, Size len) {
-    Float f = to<Float>(val);
-    glue::dtoa::doubleToString(f, buf, len);
+    char buf[MAX_NUMBER_LENGTH];
+    glue::dtoa::doubleToString(d, buf, MAX_NUMBER_LENGTH);
+    Size n = 0;
+    for (; buf[n]; n++) {
+        out[n] = static_cast<C>(buf[n]);
+    }
+    return n;
 }
 
-inline String::CPtr floatToString(const Value& val) {
-    const Size kLen = 64;
-    char buf[kLen];
-    floatToString(val, buf, kLen);
-    return String::create(buf);
+inline String::CPtr integerToString(const Value& val) {
+    char buf[MAX_INTEGER_LENGTH];
+    Size n = formatInteger(val, buf);
+    return String::create(buf, String::UTF8, n);
 }
 
-inline void doubleToString(const Value& val, char* buf, Size len) {
-    Double d = to<Double>(val);
-    glue::dtoa::doubleToString(d, buf, len);
+inline String::CPtr floatToString(const Value& val) {
+    char buf[MAX_NUMBER_LENGTH];
+    Size n = formatDouble<char>(to<Float>(val), buf);
+    return String::create(buf, String::UTF8, n);
 }
 
 inline String::CPtr doubleToString(const Value& val) {
-    const Size kLen = 64;
-    char buf[kLen];
-    doubleToString(val, buf, kLen);
-    return String::create(buf);
+    char buf[MAX_NUMBER_LENGTH];
+    Size n = formatDouble(to<Double>(val), buf);
+    return String::create(buf, String::UTF8, n);
 }
 
 }  // namespace detail
@@ -6,6 +6,10 @@
 #include <libj/typedef.h>
 #include <libj/detail/pointer.h>
 
+#ifdef LIBJ_USE_THREAD
+# include <libj/detail/atomic.h>
+#endif
+
 #ifdef LIBJ_USE_CXX11
 # include <type_traits>
 #else
@@ -30,16 +34,34 @@ enum TypeCompre {
     TYPE_CMP_NA          = 4,
 };
 
+#ifdef LIBJ_USE_INTRUSIVE_PTR
+class ObjectBase : public RefCount {};
+#else
 class ObjectBase {};
+#endif
 class MutableBase {};
 class ImmutableBase {};
 class SingletonBase {};
 
+// a TypeId is the address of the TypeInfo of the type.
+// level is the depth of a class in its hierarchy (Object is 1),
+// assigned when its ancestry is created, 0 until then.
+// with threads, it is published with release/acquire
+// since instanceof may read it while another thread assigns it.
+class TypeInfo {
+ public:
+#ifdef LIBJ_USE_THREAD
+    LIBJ_DETAIL_ATOMIC(Size) level;
+#else
+    Size level;
+#endif
+};
+
 }  // namespace detail
 }  // namespace libj
 
 #define LIBJ_RETURN_TYPE_ID \
-    static char c; \
-    return reinterpret_cast<TypeId>(&c);
+    static libj::detail::TypeInfo info; \
+    return reinterpret_cast<TypeId>(&info);
 
 #endif  // LIBJ_DETAIL_TYPE_H_
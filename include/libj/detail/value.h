@@ -12,105 +12,325 @@
 
 #include <libj/detail/classify.h>
 
+#include <string.h>
+#include <new>
+
 #ifdef LIBJ_USE_CXX11
 # include <type_traits>
+# include <utility>
 #else
+# include <boost/type_traits/alignment_of.hpp>
+# include <boost/type_traits/is_arithmetic.hpp>
 # include <boost/type_traits/remove_const.hpp>
 # include <boost/type_traits/remove_reference.hpp>
 #endif
 
+#ifdef LIBJ_USE_CXX11
+# define LIBJ_MOVE(V) std::move(V)
+#else
+# define LIBJ_MOVE(V) (V)
+#endif
+
 namespace libj {
 namespace detail {
 
+#ifdef LIBJ_USE_CXX11
+
+template<typename T>
+class remove_const {
+ public:
+    typedef typename std::remove_const<T>::type type;
+};
+
+template<typename T>
+class remove_reference {
+ public:
+    typedef typename std::remove_reference<T>::type type;
+};
+
+template<typename T>
+class remove_reference_and_const {
+ private:
+    typedef typename std::remove_reference<T>::type nonref;
+
+ public:
+    typedef typename std::remove_const<nonref>::type type;
+};
+
+template<typename T>
+class alignment_of {
+ public:
+    static const Size value = std::alignment_of<T>::value;
+};
+
+template<typename T>
+class is_arithmetic {
+ public:
+    static const Boolean value = std::is_arithmetic<T>::value;
+};
+
+#else  // LIBJ_USE_CXX11
+
+template<typename T>
+class remove_const {
+ public:
+    typedef typename boost::remove_const<T>::type type;
+};
+
+template<typename T>
+class remove_reference {
+ public:
+    typedef typename boost::remove_reference<T>::type type;
+};
+
+template<typename T>
+class remove_reference_and_const {
+ private:
+    typedef typename boost::remove_reference<T>::type nonref;
+
+ public:
+    typedef typename boost::remove_const<nonref>::type type;
+};
+
+template<typename T>
+class alignment_of {
+ public:
+    static const Size value = boost::alignment_of<T>::value;
+};
+
+template<typename T>
+class is_arithmetic {
+ public:
+    static const Boolean value = boost::is_arithmetic<T>::value;
+};
+
+#endif  // LIBJ_USE_CXX11
+
+// compares primitives by < and >.
+// NaN is greater than any other number and equal only to NaN,
+// so that the order is total and consistent with primitive_hash.
+template<typename T>
+class primitive_compare {
+ public:
+    static Int compare(const T& t, const T& u) {
+        if (t < u) {
+            return -TYPE_CMP_SAME;
+        } else if (t > u) {
+            return TYPE_CMP_SAME;
+        } else {
+            return 0;
+        }
+    }
+};
+
+template<>
+class primitive_compare<Double> {
+ public:
+    static Int compare(const Double& d, const Double& e) {
+        if (d < e) {
+            return -TYPE_CMP_SAME;
+        } else if (d > e) {
+            return TYPE_CMP_SAME;
+        } else if (d == e) {
+            return 0;
+        } else if (d != d) {
+            return e != e ? 0 : TYPE_CMP_SAME;
+        } else {
+            return -TYPE_CMP_SAME;
+        }
+    }
+};
+
+template<>
+class primitive_compare<Float> {
+ public:
+    static Int compare(const Float& f, const Float& g) {
+        return primitive_compare<Double>::compare(f, g);
+    }
+};
+
+// the hash codes of primitives, consistent with primitive_compare.
+// the other primitives all have the same hash code.
+template<typename T, Boolean IsArithmetic = is_arithmetic<T>::value>
+class primitive_hash {
+ public:
+    static Size hash(const T& t) {
+        return 0;
+    }
+};
+
+template<typename T>
+class primitive_hash<T, true> {
+ public:
+    static Size hash(const T& t) {
+        return static_cast<Size>(t);
+    }
+};
+
+// 0 and -0 are equal, and so are NaNs
+template<>
+class primitive_hash<Double, true> {
+ public:
+    static Size hash(const Double& d) {
+        if (d == 0 || d != d) return 0;
+
+        ULong u;
+        memcpy(&u, &d, sizeof(u));
+        return static_cast<Size>(u ^ (u >> 32));
+    }
+};
+
+template<>
+class primitive_hash<Float, true> {
+ public:
+    static Size hash(const Float& f) {
+        return primitive_hash<Double>::hash(f);
+    }
+};
+
 class Value {
  public:
-    Value() : content(0) {}
+    Value() : content(0), kind(KIND_UNDEFINED), typeId(0) {}
+
+#ifdef LIBJ_USE_CXX11
+    template<typename T>
+    Value(
+        T&& value,
+        typename std::enable_if<!std::is_same<
+            typename remove_reference_and_const<T>::type,
+            Value>::value>::type* = 0)
+        : content(storage_policy<
+            holder<typename remove_reference_and_const<T>::type> >::create(
+                std::forward<T>(value), &storage)) {
+        tag<typename remove_reference_and_const<T>::type>();
+    }
 
+    Value(Value&& other)
+        : content(other.content ? other.content->relocate(&storage) : 0)
+        , kind(other.kind)
+        , typeId(other.typeId) {
+        other.content = 0;
+        other.kind = KIND_UNDEFINED;
+        other.typeId = 0;
+    }
+#else
     template<typename T>
     Value(const T& value)
-        : content(new holder<T>(value)) {}
+        : content(storage_policy<holder<T> >::create(value, &storage)) {
+        tag<T>();
+    }
+#endif
 
     Value(const Value& other)
-        : content(other.content ? other.content->clone() : 0) {}
+        : content(other.content ? other.content->clone(&storage) : 0)
+        , kind(other.kind)
+        , typeId(other.typeId) {}
 
     ~Value() {
-        delete content;
+        if (content) content->destroy();
     }
 
  public:
     Value& swap(Value& rhs) {
-        std::swap(content, rhs.content);
+        Value tmp;
+        tmp.take(*this);
+        take(rhs);
+        rhs.take(tmp);
         return *this;
     }
 
+#ifdef LIBJ_USE_CXX11
     template<typename T>
-    Value& operator=(const T& rhs) {
-        Value(rhs).swap(*this);
+    Value& operator=(T&& rhs) {
+        Value tmp(std::forward<T>(rhs));
+        return take(tmp);
+    }
+
+    Value& operator=(Value&& rhs) {
+        if (this != &rhs) take(rhs);
         return *this;
     }
+#else
+    template<typename T>
+    Value& operator=(const T& rhs) {
+        Value tmp(rhs);
+        return take(tmp);
+    }
+#endif
 
-    Value& operator=(Value rhs) {
-        rhs.swap(*this);
+    Value& operator=(const Value& rhs) {
+        if (this != &rhs) {
+            Value tmp(rhs);
+            take(tmp);
+        }
         return *this;
     }
 
  public:
     TypeId type() const {
-        return content ? content->type() : 0;
+        return typeId;
     }
 
     Boolean instanceof(TypeId id) const {
-        return content ? content->instanceof(id) : false;
+        return isObject() ? content->instanceof(id) : false;
     }
 
     Boolean isUndefined() const {
-        return !content;
+        return kind == KIND_UNDEFINED;
     }
 
     Boolean isNull() const {
-        return content ? content->isNull() : false;
+        return kind == KIND_NULL;
     }
 
     Boolean isPrimitive() const {
-        return content ? content->isPrimitive() : false;
+        return kind == KIND_PRIMITIVE;
     }
 
     Boolean isObject() const {
-        return content ? content->isObject() : false;
+        return kind == KIND_PTR || kind == KIND_CPTR;
     }
 
     Boolean isPtr() const {
-        return content ? content->isPtr() : false;
+        return kind == KIND_PTR || kind == KIND_NULL;
     }
 
     Boolean isCPtr() const {
-        return content ? content->isCPtr() : false;
+        return kind == KIND_CPTR || kind == KIND_NULL;
     }
 
     template<typename T>
     Boolean is() const {
-        if (isNull()) {
+        switch (kind) {
+        case KIND_PRIMITIVE:
+            return typeId == Type<T>::id();
+        case KIND_PTR:
+        case KIND_CPTR:
+            return content->instanceof(Type<T>::id());
+        default:
             return false;
-        } else if (isObject()) {
-            return instanceof(Type<T>::id());
-        } else {
-            return type() == Type<T>::id();
         }
     }
 
     Int compareTo(const Value& val) const {
-        if (content) {
-            if (val.content) {
+        if (isUndefined()) {
+            return val.isUndefined() ? 0 : -TYPE_CMP_NA;
+        } else if (val.isUndefined()) {
+            return TYPE_CMP_NA;
+        } else if (isPrimitive() || val.isPrimitive()) {
+            if (typeId == val.typeId) {
                 return content->compareTo(val.content);
             } else {
-                return TYPE_CMP_NA;
+                return typeId < val.typeId
+                    ? -TYPE_CMP_NOT_DERIVED
+                    : TYPE_CMP_NOT_DERIVED;
             }
+        } else if (isNull()) {
+            return val.isNull() ? 0 : -TYPE_CMP_NOT_DERIVED;
+        } else if (val.isNull()) {
+            return TYPE_CMP_NOT_DERIVED;
         } else {
-            if (val.content) {
-                return -TYPE_CMP_NA;
-            } else {
-                return 0;
-            }
+            return content->compareTo(val.content);
         }
     }
 
@@ -118,6 +338,18 @@ class Value {
         return !compareTo(val);
     }
 
+    // equal values have the same hash code
+    Size hashCode() const {
+        switch (kind) {
+        case KIND_UNDEFINED:
+            return 0;
+        case KIND_NULL:
+            return 1;
+        default:
+            return content->hashCode();
+        }
+    }
+
     Boolean operator==(const Value& val) const {
         return equals(val);
     }
@@ -143,30 +375,95 @@ class Value {
     }
 
  private:
+    // small values (primitives and smart pointers) are held in place
+    union Storage {
+        void* ptr;
+        Long l;
+        Double d;
+        char buf[sizeof(void*) * 3];
+    };
+
+    // cached at construction so that type checks need no virtual calls
+    enum Kind {
+        KIND_UNDEFINED,
+        KIND_NULL,
+        KIND_PRIMITIVE,
+        KIND_PTR,
+        KIND_CPTR
+    };
+
     class placeholder {
      public:
         virtual ~placeholder() {}
 
      public:
-        virtual TypeId type() const = 0;
-
         virtual TypeId objectType() const = 0;
 
         virtual Boolean instanceof(TypeId id) const = 0;
 
-        virtual Boolean isNull() const = 0;
+        virtual Int compareTo(placeholder* other) const = 0;
 
-        virtual Boolean isPrimitive() const = 0;
+        virtual Size hashCode() const = 0;
 
-        virtual Boolean isObject() const = 0;
+        virtual placeholder* clone(Storage* storage) const = 0;
 
-        virtual Boolean isPtr() const = 0;
+        virtual placeholder* relocate(Storage* storage) = 0;
 
-        virtual Boolean isCPtr() const = 0;
+        virtual void destroy() = 0;
+    };
 
-        virtual Int compareTo(placeholder* other) const = 0;
+    template<
+        typename H,
+        Boolean InPlace =
+            sizeof(H) <= sizeof(Storage) &&
+            alignment_of<H>::value <= alignment_of<Storage>::value>
+    class storage_policy {
+     public:
+#ifdef LIBJ_USE_CXX11
+        template<typename T>
+        static placeholder* create(T&& value, Storage* storage) {
+            return new(storage) H(std::forward<T>(value));
+        }
+#else
+        template<typename T>
+        static placeholder* create(const T& value, Storage* storage) {
+            return new(storage) H(value);
+        }
+#endif
+
+        static placeholder* relocate(H* h, Storage* storage) {
+            placeholder* p = new(storage) H(LIBJ_MOVE(h->held));
+            h->~H();
+            return p;
+        }
+
+        static void destroy(H* h) {
+            h->~H();
+        }
+    };
+
+    template<typename H>
+    class storage_policy<H, false> {
+     public:
+#ifdef LIBJ_USE_CXX11
+        template<typename T>
+        static placeholder* create(T&& value, Storage* storage) {
+            return new H(std::forward<T>(value));
+        }
+#else
+        template<typename T>
+        static placeholder* create(const T& value, Storage* storage) {
+            return new H(value);
+        }
+#endif
 
-        virtual placeholder* clone() const = 0;
+        static placeholder* relocate(H* h, Storage* storage) {
+            return h;
+        }
+
+        static void destroy(H* h) {
+            delete h;
+        }
     };
 
     template<
@@ -177,9 +474,17 @@ class Value {
      public:
         holder(const T& value) : held(value) {}
 
+#ifdef LIBJ_USE_CXX11
+        holder(T&& value) : held(std::move(value)) {}
+#endif
+
      public:
-        virtual TypeId type() const {
-            return held ? Type<T>::id() : 1;
+        static Kind kindOf(const T& held) {
+            if (held) {
+                return IsCPtr ? KIND_CPTR : KIND_PTR;
+            } else {
+                return KIND_NULL;
+            }
         }
 
         virtual TypeId objectType() const {
@@ -190,55 +495,39 @@ class Value {
             return held ? held->instanceof(id) : false;
         }
 
-        virtual Boolean isNull() const {
-            return !held;
-        }
-
-        virtual Boolean isPrimitive() const {
-            return false;
-        }
-
-        virtual Boolean isObject() const {
-            return !!held;
+        // both this and that hold non-null objects
+        virtual Int compareTo(placeholder* that) const {
+            TypeId thisId = this->objectType();
+            TypeId thatId = that->objectType();
+            if (thisId == thatId) {
+                const T& thatHeld = static_cast<holder<T>*>(that)->held;
+                return this->held->compareTo(thatHeld);
+            } else if (this->instanceof(thatId)) {
+                return TYPE_CMP_DERIVED;
+            } else if (that->instanceof(thisId)) {
+                return -TYPE_CMP_DERIVED;
+            } else {
+                return thisId < thatId
+                    ? -TYPE_CMP_NOT_DERIVED
+                    : TYPE_CMP_NOT_DERIVED;
+            }
         }
 
-        virtual Boolean isPtr() const {
-            return held ? !IsCPtr : true;
+        // this holds a non-null object
+        virtual Size hashCode() const {
+            return this->held->hashCode();
         }
 
-        virtual Boolean isCPtr() const {
-            return held ? IsCPtr : true;
+        virtual placeholder* clone(Storage* storage) const {
+            return storage_policy<holder>::create(held, storage);
         }
 
-        virtual Int compareTo(placeholder* that) const {
-            if (that->isPtr() || that->isCPtr()) {
-                TypeId thisId = this->objectType();
-                TypeId thatId = that->objectType();
-                if (thisId == thatId) {
-                    T thatHeld = static_cast<holder<T>*>(that)->held;
-                    return this->held
-                            ? this->held->compareTo(thatHeld)
-                            : 0;
-                } else if (this->instanceof(thatId)) {
-                    return TYPE_CMP_DERIVED;
-                } else if (that->instanceof(thisId)) {
-                    return -TYPE_CMP_DERIVED;
-                } else {
-                    return thisId < thatId
-                        ? -TYPE_CMP_NOT_DERIVED
-                        : TYPE_CMP_NOT_DERIVED;
-                }
-            } else {
-                TypeId thisId = this->type();
-                TypeId thatId = that->type();
-                return thisId < thatId
-                        ? -TYPE_CMP_NOT_DERIVED
-                        : TYPE_CMP_NOT_DERIVED;
-            }
+        virtual placeholder* relocate(Storage* storage) {
+            return storage_policy<holder>::relocate(this, storage);
         }
 
-        virtual placeholder* clone() const {
-            return new holder(held);
+        virtual void destroy() {
+            storage_policy<holder>::destroy(this);
         }
 
      public:
@@ -253,9 +542,13 @@ class Value {
      public:
         holder(const T& value) : held(value) {}
 
+#ifdef LIBJ_USE_CXX11
+        holder(T&& value) : held(std::move(value)) {}
+#endif
+
      public:
-        virtual TypeId type() const {
-            return Type<T>::id();
+        static Kind kindOf(const T& held) {
+            return KIND_PRIMITIVE;
         }
 
         virtual TypeId objectType() const {
@@ -266,47 +559,26 @@ class Value {
             return false;
         }
 
-        virtual Boolean isNull() const {
-            return false;
-        }
-
-        virtual Boolean isPrimitive() const {
-            return true;
-        }
-
-        virtual Boolean isObject() const {
-            return false;
+        // that holds a value of the same type
+        virtual Int compareTo(placeholder* that) const {
+            const T& thatHeld = static_cast<holder<T>*>(that)->held;
+            return primitive_compare<T>::compare(this->held, thatHeld);
         }
 
-        virtual Boolean isPtr() const {
-            return false;
+        virtual Size hashCode() const {
+            return primitive_hash<T>::hash(this->held);
         }
 
-        virtual Boolean isCPtr() const {
-            return false;
+        virtual placeholder* clone(Storage* storage) const {
+            return storage_policy<holder>::create(held, storage);
         }
 
-        virtual Int compareTo(placeholder* that) const {
-            TypeId thisId = this->type();
-            TypeId thatId = that->type();
-            if (thisId == thatId) {
-                T thatHeld = static_cast<holder<T>*>(that)->held;
-                if (this->held < thatHeld) {
-                    return -TYPE_CMP_SAME;
-                } else if (this->held > thatHeld) {
-                    return TYPE_CMP_SAME;
-                } else {
-                    return 0;
-                }
-            } else {
-                return thisId < thatId
-                    ? -TYPE_CMP_NOT_DERIVED
-                    : TYPE_CMP_NOT_DERIVED;
-            }
+        virtual placeholder* relocate(Storage* storage) {
+            return storage_policy<holder>::relocate(this, storage);
         }
 
-        virtual placeholder* clone() const {
-            return new holder(held);
+        virtual void destroy() {
+            storage_policy<holder>::destroy(this);
         }
 
      public:
@@ -323,57 +595,29 @@ class Value {
         T** out,
         Boolean instanceof = false);
 
-    placeholder* content;
-};
-
-#ifdef LIBJ_USE_CXX11
-
-template<typename T>
-class remove_const {
- public:
-    typedef typename std::remove_const<T>::type type;
-};
-
-template<typename T>
-class remove_reference {
- public:
-    typedef typename std::remove_reference<T>::type type;
-};
-
-template<typename T>
-class remove_reference_and_const {
- private:
-    typedef typename std::remove_reference<T>::type nonref;
-
- public:
-    typedef typename std::remove_const<nonref>::type type;
-};
-
-#else  // LIBJ_USE_CXX11
-
-template<typename T>
-class remove_const {
- public:
-    typedef typename boost::remove_const<T>::type type;
-};
-
-template<typename T>
-class remove_reference {
- public:
-    typedef typename boost::remove_reference<T>::type type;
-};
+    template<typename T>
+    void tag() {
+        kind = holder<T>::kindOf(static_cast<holder<T>*>(content)->held);
+        typeId = kind == KIND_NULL ? 1 : Type<T>::id();
+    }
 
-template<typename T>
-class remove_reference_and_const {
- private:
-    typedef typename boost::remove_reference<T>::type nonref;
+    Value& take(Value& other) {
+        if (content) content->destroy();
+        content = other.content ? other.content->relocate(&storage) : 0;
+        kind = other.kind;
+        typeId = other.typeId;
+        other.content = 0;
+        other.kind = KIND_UNDEFINED;
+        other.typeId = 0;
+        return *this;
+    }
 
- public:
-    typedef typename boost::remove_const<nonref>::type type;
+    placeholder* content;
+    Kind kind;
+    TypeId typeId;
+    Storage storage;
 };
 
-#endif  // LIBJ_USE_CXX11
-
 template<typename T>
 inline Boolean _to(Value* operand, T** out, Boolean instanceof) {
     if (operand &&
@@ -65,6 +65,39 @@ std::u32string utf16ToUtf32(const std::u16string& str);
 
 std::u16string utf32ToUtf16(const std::u32string& str);
 
+// decodes UTF-8 given in chunks of any size.
+// a sequence split across chunks is carried over to the next one,
+// and illegal sequences are replaced by U+FFFD.
+class Utf8Decoder {
+ public:
+    Utf8Decoder();
+
+    // appends the characters decoded from data[0, len) to str
+    void decode(const void* data, size_t len, std::u16string* str);
+
+    void decode(const void* data, size_t len, std::u32string* str);
+
+    // writes the characters to d, which needs room for len + 1 units,
+    // and returns the number of units written
+    size_t decode(const void* data, size_t len, char16_t* d);
+
+    size_t decode(const void* data, size_t len, char32_t* d);
+
+    // ends the input, appending U+FFFD if a sequence is left incomplete
+    void flush(std::u16string* str);
+
+    void flush(std::u32string* str);
+
+    // returns whether a sequence is left incomplete
+    bool pending() const;
+
+    void reset();
+
+ private:
+    unsigned char buf_[4];
+    size_t len_;
+};
+
 }  // namespace glue
 }  // namespace libj
 
@@ -0,0 +1,18 @@
+// Copyright (c) 2013 Plenluno All rights reserved.
+
+#ifndef LIBJ_HASH_MAP_H_
+#define LIBJ_HASH_MAP_H_
+
+#include <libj/map.h>
+
+namespace libj {
+
+// a Map which finds the keys by their hash codes instead of their order
+class HashMap : LIBJ_MAP(HashMap)
+ public:
+    static Ptr create();
+};
+
+}  // namespace libj
+
+#endif  // LIBJ_HASH_MAP_H_
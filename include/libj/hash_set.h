@@ -0,0 +1,18 @@
+// Copyright (c) 2013 Plenluno All rights reserved.
+
+#ifndef LIBJ_HASH_SET_H_
+#define LIBJ_HASH_SET_H_
+
+#include <libj/set.h>
+
+namespace libj {
+
+// a Set which finds the values by their hash codes instead of their order
+class HashSet : LIBJ_SET(HashSet)
+ public:
+    static Ptr create();
+};
+
+}  // namespace libj
+
+#endif  // LIBJ_HASH_SET_H_
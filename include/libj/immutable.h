@@ -20,6 +20,8 @@ class Immutable
     virtual CPtr self() const;
 
     virtual Boolean instanceof(TypeId id) const;
+
+    static const TypeId* ancestry();
 };
 
 }  // namespace libj
@@ -17,8 +17,13 @@ inline Immutable::CPtr Immutable::self() const {
 }
 
 inline Boolean Immutable::instanceof(TypeId id) const {
-    return id == Type<Immutable>::id()
-        || Object::instanceof(id);
+    return detail::inAncestry(ancestry(), id);
+}
+
+inline const TypeId* Immutable::ancestry() {
+    static const TypeId* a =
+        detail::createAncestry(Type<Immutable>::id(), Object::ancestry());
+    return a;
 }
 
 }  // namespace libj
@@ -29,8 +34,9 @@ inline Boolean Immutable::instanceof(TypeId id) const {
     } \
     virtual Boolean instanceof(libj::TypeId id) const { \
         return id == libj::Type<T>::id() \
-            || B::instanceof(id); \
-    }
+            || libj::detail::inAncestry(ancestry(), id); \
+    } \
+    LIBJ_ANCESTRY_DEF(T, B)
 
 #define LIBJ_IMMUTABLE_DEFS(T, B) public: \
     typedef LIBJ_CPTR(T) CPtr; \
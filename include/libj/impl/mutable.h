@@ -21,8 +21,13 @@ inline Mutable::CPtr Mutable::celf() const {
 }
 
 inline Boolean Mutable::instanceof(TypeId id) const {
-    return id == Type<Mutable>::id()
-        || Object::instanceof(id);
+    return detail::inAncestry(ancestry(), id);
+}
+
+inline const TypeId* Mutable::ancestry() {
+    static const TypeId* a =
+        detail::createAncestry(Type<Mutable>::id(), Object::ancestry());
+    return a;
 }
 
 }  // namespace libj
@@ -33,8 +38,9 @@ inline Boolean Mutable::instanceof(TypeId id) const {
     } \
     virtual Boolean instanceof(libj::TypeId id) const { \
         return id == libj::Type<T >::id() \
-            || B::instanceof(id); \
-    }
+            || libj::detail::inAncestry(ancestry(), id); \
+    } \
+    LIBJ_ANCESTRY_DEF(T, B)
 
 #define LIBJ_MUTABLE_DEFS(T, B) public: \
     typedef LIBJ_PTR(T) Ptr; \
@@ -10,6 +10,12 @@ inline Object::CPtr Object::null() {
     return nullp;
 }
 
+inline const TypeId* Object::ancestry() {
+    static const TypeId* a =
+        detail::createAncestry(Type<Object>::id());
+    return a;
+}
+
 inline Boolean Object::instanceof(TypeId id) const {
     return id == Type<Object>::id();
 }
@@ -43,6 +49,11 @@ inline Boolean Object::equals(Object::CPtr that) const {
     return !compareTo(that);
 }
 
+// consistent with equals, which compares identities
+inline Size Object::hashCode() const {
+    return reinterpret_cast<Size>(static_cast<const Object*>(this));
+}
+
 template<typename T>
 inline Boolean Object::is() const {
     return this->instanceof(Type<T>::id());
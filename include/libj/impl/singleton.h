@@ -10,6 +10,12 @@ inline Singleton::Ptr Singleton::null() {
     return nullp;
 }
 
+inline const TypeId* Singleton::ancestry() {
+    static const TypeId* a =
+        detail::createAncestry(Type<Singleton>::id(), Object::ancestry());
+    return a;
+}
+
 template<typename T>
 class SingletonTmpl : public Singleton {
  public:
@@ -32,13 +38,19 @@ class SingletonTmpl : public Singleton {
     }
 
     virtual Boolean instanceof(TypeId id) const {
-        return id == type()
-            || id == Type<Singleton>::id()
-            || Object::instanceof(id);
+        return id == Type<T>::id()
+            || detail::inAncestry(ancestry(), id);
     }
 
+    LIBJ_ANCESTRY_DEF(T, Singleton)
+
  protected:
-    SingletonTmpl() {}
+    SingletonTmpl() {
+#ifdef LIBJ_USE_INTRUSIVE_PTR
+        // the static instance must never be deleted
+        intrusive_ptr_add_ref(this);
+#endif
+    }
     virtual ~SingletonTmpl() {}
 };
 
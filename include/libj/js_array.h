@@ -21,6 +21,10 @@ class JsArray : LIBJ_ARRAY_LIST(JsArray)
 
     virtual Value deleteProperty(const Value& name) = 0;
 
+    // a null separator is a comma
+    virtual String::CPtr join(
+        String::CPtr separator = String::null()) const = 0;
+
     template<typename T>
     typename Type<T>::Ptr getPtr(Size index) const;
 
@@ -4,6 +4,7 @@
 #define LIBJ_JS_OBJECT_H_
 
 #include <libj/map.h>
+#include <libj/js_property_key.h>
 
 namespace libj {
 
@@ -19,6 +20,12 @@ class JsObject : LIBJ_MAP(JsObject)
 
     virtual Value deleteProperty(const Value& name) = 0;
 
+    virtual Boolean hasProperty(const JsPropertyKey& key) const = 0;
+
+    virtual Value getProperty(const JsPropertyKey& key) const = 0;
+
+    virtual Value setProperty(const JsPropertyKey& key, const Value& val) = 0;
+
     template<typename T>
     typename Type<T>::Ptr getPtr(const Value& name) const;
 
@@ -0,0 +1,82 @@
+// Copyright (c) 2013 Plenluno All rights reserved.
+
+#ifndef LIBJ_JS_PROPERTY_KEY_H_
+#define LIBJ_JS_PROPERTY_KEY_H_
+
+#include <libj/symbol.h>
+#include <libj/detail/noncopyable.h>
+
+#ifdef LIBJ_USE_THREAD
+# include <libj/detail/atomic.h>
+#endif
+
+namespace libj {
+
+namespace detail {
+
+template<typename I>
+class JsObject;
+
+}  // namespace detail
+
+// the name of a property interned as a symbol, which remembers where
+// the property was found last time. getting or setting the property of
+// a JsObject with the same keys in the same order is then a compare and
+// a load, without converting or looking up the name.
+//
+// a key is meant to be defined once and reused, like a static symbol:
+//
+//     LIBJ_STATIC_JS_PROPERTY_KEY_DEF(keyName, "name");
+//     Value name = obj->getProperty(keyName);
+class JsPropertyKey : private detail::NonCopyable {
+ public:
+    explicit JsPropertyKey(const char* name)
+        : name_(Symbol::create(name))
+        , cache_(0) {}
+
+    explicit JsPropertyKey(String::CPtr name)
+        : name_(Symbol::create(name))
+        , cache_(0) {}
+
+    String::CPtr name() const {
+        return name_;
+    }
+
+ private:
+    Symbol::CPtr name_;
+
+#ifdef LIBJ_USE_THREAD
+    mutable LIBJ_DETAIL_ATOMIC(Size) cache_;
+
+    Size cache() const {
+        return cache_.load(LIBJ_DETAIL_MEMORY_ORDER(relaxed));
+    }
+
+    void setCache(Size entry) const {
+        cache_.store(entry, LIBJ_DETAIL_MEMORY_ORDER(relaxed));
+    }
+#else
+    mutable Size cache_;
+
+    Size cache() const {
+        return cache_;
+    }
+
+    void setCache(Size entry) const {
+        cache_ = entry;
+    }
+#endif
+
+    template<typename I>
+    friend class detail::JsObject;
+};
+
+}  // namespace libj
+
+#define LIBJ_JS_PROPERTY_KEY_DEF(N, V) \
+    libj::JsPropertyKey N(V);
+
+#define LIBJ_STATIC_JS_PROPERTY_KEY_DEF(N, V) \
+    static libj::JsPropertyKey N(V);
+
+#endif  // LIBJ_JS_PROPERTY_KEY_H_
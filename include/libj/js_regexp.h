@@ -32,6 +32,10 @@ class JsRegExp : LIBJ_JS_OBJECT(JsRegExp)
     virtual JsArray::Ptr exec(String::CPtr str) = 0;
 
     virtual Boolean test(String::CPtr str) = 0;
+
+    // ignores global and lastIndex, as String.split of ECMAScript
+    virtual JsArray::Ptr split(
+        String::CPtr str, Size limit = NO_SIZE) const = 0;
 };
 
 }  // namespace libj
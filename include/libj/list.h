@@ -39,6 +39,15 @@ class List : LIBJ_COLLECTION(List)
     virtual Size push(const Value& val) = 0;
 
     virtual Value pop() = 0;
+
+#ifdef LIBJ_USE_CXX11
+ public:
+    virtual Boolean add(Value&& val) = 0;
+
+    virtual Boolean add(Size index, Value&& val) = 0;
+
+    virtual Size push(Value&& val) = 0;
+#endif
 };
 
 }  // namespace libj
@@ -35,7 +35,14 @@ class Map : LIBJ_MUTABLE(Map)
 
     virtual Value remove(const Value& key) = 0;
 
+    virtual void putAll(CPtr map) = 0;
+
     virtual Size size() const = 0;
+
+#ifdef LIBJ_USE_CXX11
+ public:
+    virtual Value put(Value&& key, Value&& val) = 0;
+#endif
 };
 
 }  // namespace libj
@@ -23,6 +23,8 @@ class Mutable
     virtual CPtr celf() const;
 
     virtual Boolean instanceof(TypeId id) const;
+
+    static const TypeId* ancestry();
 };
 
 }  // namespace libj
@@ -4,6 +4,7 @@
 #define LIBJ_OBJECT_H_
 
 #include <libj/type.h>
+#include <libj/detail/ancestry.h>
 #include <libj/detail/noncopyable.h>
 
 namespace libj {
@@ -18,12 +19,16 @@ class Object
 
     static CPtr null();
 
+    static const TypeId* ancestry();
+
     virtual Boolean instanceof(TypeId id) const;
 
     virtual Int compareTo(CPtr that) const;
 
     virtual Boolean equals(CPtr that) const;
 
+    virtual Size hashCode() const;
+
     virtual TypeId type() const = 0;
 
     virtual LIBJ_CPTR(String) toString() const = 0;
@@ -14,4 +14,7 @@ class Set : LIBJ_COLLECTION(Set)
 
 }  // namespace libj
 
+#define LIBJ_SET(T) public libj::Set { \
+    LIBJ_MUTABLE_DEFS(T, libj::Set)
+
 #endif  // LIBJ_SET_H_
@@ -16,6 +16,8 @@ class Singleton
     typedef LIBJ_CPTR(Singleton) CPtr;
 
     static Ptr null();
+
+    static const TypeId* ancestry();
 };
 
 }  // namespace libj
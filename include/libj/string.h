@@ -12,6 +12,9 @@
 
 namespace libj {
 
+class JsArray;
+class JsRegExp;
+
 class String : LIBJ_IMMUTABLE(String)
  public:
     enum Encoding {
@@ -38,7 +41,8 @@ class String : LIBJ_IMMUTABLE(String)
         Size len = NO_SIZE,
         Size max = NO_SIZE);
 
-    static CPtr intern(CPtr str);
+    // a weak symbol is freed when it is no longer referenced
+    static CPtr intern(CPtr str, Boolean weak = false);
 
     static CPtr intern(
         const void* data,
@@ -78,6 +82,24 @@ class String : LIBJ_IMMUTABLE(String)
 
     virtual Boolean endsWith(CPtr str) const = 0;
 
+    // splits this string into at most limit pieces, as String.split of
+    // ECMAScript. if share is true, the pieces too long to be stored
+    // inline share the characters of this string, however short they are
+    // compared with it.
+    virtual LIBJ_PTR(JsArray) split(
+        Char separator,
+        Size limit = NO_SIZE,
+        Boolean share = false) const = 0;
+
+    virtual LIBJ_PTR(JsArray) split(
+        CPtr separator,
+        Size limit = NO_SIZE,
+        Boolean share = false) const = 0;
+
+    virtual LIBJ_PTR(JsArray) split(
+        LIBJ_PTR(JsRegExp) separator,
+        Size limit = NO_SIZE) const = 0;
+
     virtual CPtr toLowerCase() const = 0;
 
     virtual CPtr toUpperCase() const = 0;
@@ -99,6 +121,17 @@ String::CPtr str(const char16_t* utf16);
 
 String::CPtr str(const char32_t* utf32);
 
+// the conversions of ECMAScript, which return NaN for a null string
+Double parseInt(String::CPtr str, Int radix = 0);
+
+Double parseFloat(String::CPtr str);
+
+Double toNumber(String::CPtr str);
+
+// parses the whole string as a decimal integer with an optional sign,
+// and returns false if it is not one or out of the range of Long
+Boolean parseLong(String::CPtr str, Long* out);
+
 }  // namespace libj
 
 #include <libj/impl/string.h>
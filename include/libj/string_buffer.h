@@ -8,12 +8,20 @@
 
 namespace libj {
 
+namespace glue {
+class Utf8Decoder;
+}  // namespace glue
+
 class StringBuffer : LIBJ_MUTABLE(StringBuffer)
  public:
     static Ptr create();
 
     virtual Size length() const = 0;
 
+    virtual Size capacity() const = 0;
+
+    virtual void reserve(Size capacity) = 0;
+
     virtual Char charAt(Size index) const = 0;
 
     virtual Ptr append(const Value& val) = 0;
@@ -26,9 +34,19 @@ class StringBuffer : LIBJ_MUTABLE(StringBuffer)
 
     virtual Ptr appendStr(String::CPtr str) = 0;
 
+    // appends a chunk of UTF-8, where decoder carries the sequence split
+    // across chunks. a null data ends the input.
+    virtual Ptr appendUtf8(
+        glue::Utf8Decoder* decoder, const void* data, Size len) = 0;
+
     virtual Boolean setCharAt(Size index, Char c) = 0;
 
     virtual const Char* data() const = 0;
+
+    // returns the string built and empties this builder.
+    // unlike toString(), it takes over the buffer if it is not much
+    // larger than the string, instead of copying the characters.
+    virtual String::CPtr build() = 0;
 };
 
 }  // namespace libj
@@ -0,0 +1,27 @@
+// Copyright (c) 2013 Plenluno All rights reserved.
+
+#ifndef LIBJ_STRING_SEARCHER_H_
+#define LIBJ_STRING_SEARCHER_H_
+
+#include <libj/string.h>
+
+namespace libj {
+
+// searches strings repeatedly for the same pattern,
+// preprocessing the pattern only once
+class StringSearcher : LIBJ_IMMUTABLE(StringSearcher)
+ public:
+    static CPtr create(String::CPtr pattern);
+
+    virtual String::CPtr pattern() const = 0;
+
+    // returns the first index of pattern in str at or after from
+    virtual Size search(String::CPtr str, Size from = 0) const = 0;
+};
+
+}  // namespace libj
+
+#define LIBJ_STRING_SEARCHER(T) public libj::StringSearcher { \
+    LIBJ_IMMUTABLE_DEFS(T, libj::StringSearcher)
+
+#endif  // LIBJ_STRING_SEARCHER_H_
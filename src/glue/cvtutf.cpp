@@ -3,8 +3,10 @@
 #include <libj/config.h>
 #include <libj/endian.h>
 #include <libj/glue/cvtutf.h>
+#include <libj/detail/simd.h>
 
 #include <assert.h>
+#include <string.h>
 
 #ifdef LIBJ_USE_ICONV
 # include <errno.h>
@@ -49,6 +51,231 @@ static inline char32_t swapChar32(char32_t c32) {
     return (u32 << 16) | (u32 >> 16);
 }
 
+static inline size_t minSize(size_t a, size_t b) {
+    return a < b ? a : b;
+}
+
+// the transcoders between UTF-8 and the native UTF-16/32,
+// shared by the iconv and ConvertUTF builds.
+// runs of ASCII are copied by SIMD kernels, and the other characters
+// one by one. they stop at NUL or at an illegal sequence.
+
+// returns the length of the non-ASCII sequence at s[0, len),
+// or 0 if it is illegal or truncated
+static size_t decodeChar(const unsigned char* s, size_t len, char32_t* cp) {
+    unsigned char c = s[0];
+    size_t n;
+    char32_t v;
+    char32_t min;
+    if (c < 0xc2) {
+        return 0;
+    } else if (c < 0xe0) {
+        n = 2;
+        v = c & 0x1f;
+        min = 0x80;
+    } else if (c < 0xf0) {
+        n = 3;
+        v = c & 0x0f;
+        min = 0x800;
+    } else if (c < 0xf5) {
+        n = 4;
+        v = c & 0x07;
+        min = 0x10000;
+    } else {
+        return 0;
+    }
+    if (n > len) return 0;
+
+    for (size_t i = 1; i < n; i++) {
+        if ((s[i] & 0xc0) != 0x80) return 0;
+        v = (v << 6) | (s[i] & 0x3f);
+    }
+    if (v < min || v > 0x10ffff || (v >= 0xd800 && v <= 0xdfff)) return 0;
+
+    *cp = v;
+    return n;
+}
+
+static size_t decodeChar(const char16_t* s, size_t len, char32_t* cp) {
+    char32_t c = s[0];
+    if (!c || (c >= 0xdc00 && c <= 0xdfff)) {
+        return 0;
+    } else if (c >= 0xd800 && c <= 0xdbff) {
+        if (len < 2 || s[1] < 0xdc00 || s[1] > 0xdfff) return 0;
+
+        *cp = 0x10000 + ((c - 0xd800) << 10) + (s[1] - 0xdc00);
+        return 2;
+    } else {
+        *cp = c;
+        return 1;
+    }
+}
+
+static size_t decodeChar(const char32_t* s, size_t len, char32_t* cp) {
+    char32_t c = s[0];
+    if (!c || c > 0x10ffff || (c >= 0xd800 && c <= 0xdfff)) return 0;
+
+    *cp = c;
+    return 1;
+}
+
+static size_t encodeChar(char32_t cp, unsigned char* d) {
+    if (cp < 0x80) {
+        d[0] = static_cast<unsigned char>(cp);
+        return 1;
+    } else if (cp < 0x800) {
+        d[0] = static_cast<unsigned char>(0xc0 | (cp >> 6));
+        d[1] = static_cast<unsigned char>(0x80 | (cp & 0x3f));
+        return 2;
+    } else if (cp < 0x10000) {
+        d[0] = static_cast<unsigned char>(0xe0 | (cp >> 12));
+        d[1] = static_cast<unsigned char>(0x80 | ((cp >> 6) & 0x3f));
+        d[2] = static_cast<unsigned char>(0x80 | (cp & 0x3f));
+        return 3;
+    } else {
+        d[0] = static_cast<unsigned char>(0xf0 | (cp >> 18));
+        d[1] = static_cast<unsigned char>(0x80 | ((cp >> 12) & 0x3f));
+        d[2] = static_cast<unsigned char>(0x80 | ((cp >> 6) & 0x3f));
+        d[3] = static_cast<unsigned char>(0x80 | (cp & 0x3f));
+        return 4;
+    }
+}
+
+static size_t encodeChar(char32_t cp, char16_t* d) {
+    if (cp < 0x10000) {
+        d[0] = static_cast<char16_t>(cp);
+        return 1;
+    } else {
+        cp -= 0x10000;
+        d[0] = static_cast<char16_t>(0xd800 + (cp >> 10));
+        d[1] = static_cast<char16_t>(0xdc00 + (cp & 0x3ff));
+        return 2;
+    }
+}
+
+static size_t encodeChar(char32_t cp, char32_t* d) {
+    d[0] = cp;
+    return 1;
+}
+
+// returns the number of units up to NUL or the end of max characters,
+// reading no further than the transcoders do one by one
+static size_t unitLength(const unsigned char* s, size_t max) {
+    if (max == NO_SIZE) return strlen(reinterpret_cast<const char*>(s));
+
+    size_t i = 0;
+    for (size_t n = 0; n < max && s[i]; n++) {
+        unsigned char c = s[i];
+        size_t end = i + (c < 0xc0 ? 1 : c < 0xe0 ? 2 : c < 0xf0 ? 3 : 4);
+        for (i++; i < end && s[i]; i++) {}
+    }
+    return i;
+}
+
+static size_t unitLength(const char16_t* s, size_t max) {
+    size_t i = 0;
+    for (size_t n = 0; n < max && s[i]; n++) {
+        i += (s[i] >= 0xd800 && s[i] <= 0xdbff && s[i + 1]) ? 2 : 1;
+    }
+    return i;
+}
+
+static size_t unitLength(const char32_t* s, size_t max) {
+    size_t i = 0;
+    for (; i < max && s[i]; i++) {}
+    return i;
+}
+
+// decodes at most max characters in data[0, len)
+template<typename C>
+static std::basic_string<C> decodeUtf8(
+    const unsigned char* data,
+    size_t len,
+    size_t max,
+    size_t* n = NULL) {
+    if (len == NO_SIZE) len = unitLength(data, max);
+
+    // a character takes no more units than bytes in UTF-8
+    size_t units = sizeof(C) == 2 ? 2 : 1;
+    size_t cap = max < len / units ? max * units : len;
+    std::basic_string<C> s;
+    s.resize(cap);
+
+    size_t i = 0;
+    size_t k = 0;
+    size_t num = 0;
+    while (i < len && num < max) {
+        if (data[i] < 0x80) {
+            size_t ascii = detail::simd::widenAscii(
+                data + i, minSize(len - i, max - num), &s[0] + k);
+            i += ascii;
+            k += ascii;
+            num += ascii;
+            if (i == len || num == max) break;
+        }
+
+        char32_t cp;
+        size_t inc = decodeChar(data + i, len - i, &cp);
+        if (!inc) break;
+
+        i += inc;
+        k += encodeChar(cp, &s[0] + k);
+        num++;
+    }
+    s.resize(k);
+    if (n) *n = num;
+    return s;
+}
+
+// encodes at most max characters in data[0, len)
+template<typename C>
+static std::string encodeUtf8(
+    const C* data,
+    size_t len,
+    size_t max,
+    size_t* n = NULL) {
+    if (len == NO_SIZE) len = unitLength(data, max);
+
+    // a unit takes no more than 3 bytes in UTF-8, or 4 if it is UTF-32
+    size_t bytes = sizeof(C) == 2 ? 3 : 4;
+    std::string s;
+    s.resize(len * bytes);
+    unsigned char* d = reinterpret_cast<unsigned char*>(&s[0]);
+
+    size_t i = 0;
+    size_t k = 0;
+    size_t num = 0;
+    while (i < len && num < max) {
+        if (data[i] < 0x80) {
+            size_t ascii = detail::simd::narrowAscii(
+                data + i, minSize(len - i, max - num), d + k);
+            i += ascii;
+            k += ascii;
+            num += ascii;
+            if (i == len || num == max) break;
+        }
+
+        char32_t cp;
+        size_t inc = decodeChar(data + i, len - i, &cp);
+        if (!inc) break;
+
+        i += inc;
+        k += encodeChar(cp, d + k);
+        num++;
+    }
+    s.resize(k);
+    if (n) *n = num;
+    return s;
+}
+
+static inline bool isNativeUtf16(UnicodeEncoding enc) {
+    return (enc == UTF16BE || enc == UTF16LE) && !needsSwap(enc);
+}
+
+static inline bool isNativeUtf32(UnicodeEncoding enc) {
+    return (enc == UTF32BE || enc == UTF32LE) && !needsSwap(enc);
+}
+
 size_t byteLengthAt(const void* data, UnicodeEncoding enc) {
     switch (enc) {
     case UTF8: {
@@ -97,11 +324,7 @@ size_t byteLengthAt(const void* data, UnicodeEncoding enc) {
 std::string utf16ToUtf8(const std::u16string& str, size_t* n) {
     assert(sizeof(char16_t) == 2);
 
-    if (isBigEndian()) {
-        return toUtf8(str.c_str(), UTF16BE, NO_SIZE, NO_SIZE, n);
-    } else {
-        return toUtf8(str.c_str(), UTF16LE, NO_SIZE, NO_SIZE, n);
-    }
+    return encodeUtf8(str.c_str(), str.length(), NO_SIZE, n);
 }
 
 std::u32string utf16ToUtf32(const std::u16string& str) {
@@ -114,6 +337,173 @@ std::u32string utf16ToUtf32(const std::u16string& str) {
     }
 }
 
+static const char32_t REPLACEMENT_CHAR = 0xfffd;
+
+// returns the length of the sequence led by c, or 0 if c cannot lead one
+static inline size_t sequenceLength(unsigned char c) {
+    if (c < 0x80) {
+        return 1;
+    } else if (c < 0xc2) {
+        return 0;
+    } else if (c < 0xe0) {
+        return 2;
+    } else if (c < 0xf0) {
+        return 3;
+    } else if (c < 0xf5) {
+        return 4;
+    } else {
+        return 0;
+    }
+}
+
+// returns whether c can be the i-th byte of the sequence led by lead.
+// the second bytes are limited so that no complete sequence is
+// overlong, a surrogate or beyond U+10FFFF.
+static inline bool isTrailByte(unsigned char lead, size_t i, unsigned char c) {
+    if (i > 1) return (c & 0xc0) == 0x80;
+
+    switch (lead) {
+    case 0xe0:
+        return c >= 0xa0 && c <= 0xbf;
+    case 0xed:
+        return c >= 0x80 && c <= 0x9f;
+    case 0xf0:
+        return c >= 0x90 && c <= 0xbf;
+    case 0xf4:
+        return c >= 0x80 && c <= 0x8f;
+    default:
+        return (c & 0xc0) == 0x80;
+    }
+}
+
+static inline char32_t decodeSequence(const unsigned char* s, size_t n) {
+    char32_t cp = s[0] & (0xff >> (n + 1));
+    for (size_t i = 1; i < n; i++) {
+        cp = (cp << 6) | (s[i] & 0x3f);
+    }
+    return cp;
+}
+
+// decodes data[0, len) after the incomplete sequence buf[0, *bufLen)
+// into d, replacing the maximal subparts of illegal sequences by U+FFFD.
+// a byte decodes into no more than one unit, but completing or breaking
+// the carried sequence can add one more, so d needs len + 1 units.
+template<typename C>
+static size_t decodeChunk(
+    unsigned char* buf,
+    size_t* bufLen,
+    const unsigned char* data,
+    size_t len,
+    C* d) {
+    size_t i = 0;
+    size_t k = 0;
+    if (*bufLen) {
+        size_t n = sequenceLength(buf[0]);
+        for (; *bufLen < n && i < len; i++) {
+            if (!isTrailByte(buf[0], *bufLen, data[i])) break;
+            buf[(*bufLen)++] = data[i];
+        }
+        if (*bufLen == n) {
+            k += encodeChar(decodeSequence(buf, n), d + k);
+            *bufLen = 0;
+        } else if (i < len) {
+            d[k++] = static_cast<C>(REPLACEMENT_CHAR);
+            *bufLen = 0;
+        }
+    }
+
+    while (i < len) {
+        unsigned char c = data[i];
+        if (c < 0x80) {
+            size_t ascii = detail::simd::widenAscii(data + i, len - i, d + k);
+            if (!ascii) {
+                d[k] = 0;
+                ascii = 1;
+            }
+            i += ascii;
+            k += ascii;
+            continue;
+        }
+
+        size_t n = sequenceLength(c);
+        if (!n) {
+            d[k++] = static_cast<C>(REPLACEMENT_CHAR);
+            i++;
+            continue;
+        }
+
+        size_t j = 1;
+        while (j < n && i + j < len && isTrailByte(c, j, data[i + j])) j++;
+        if (j == n) {
+            k += encodeChar(decodeSequence(data + i, n), d + k);
+        } else if (i + j == len) {
+            memcpy(buf, data + i, j);
+            *bufLen = j;
+        } else {
+            d[k++] = static_cast<C>(REPLACEMENT_CHAR);
+        }
+        i += j;
+    }
+    return k;
+}
+
+template<typename C>
+static void decodeChunk(
+    unsigned char* buf,
+    size_t* bufLen,
+    const unsigned char* data,
+    size_t len,
+    std::basic_string<C>* str) {
+    size_t k = str->length();
+    str->resize(k + len + 1);
+    k += decodeChunk(buf, bufLen, data, len, &(*str)[0] + k);
+    str->resize(k);
+}
+
+Utf8Decoder::Utf8Decoder() : len_(0) {}
+
+void Utf8Decoder::decode(const void* data, size_t len, std::u16string* str) {
+    assert(str);
+    decodeChunk(buf_, &len_, static_cast<const unsigned char*>(data), len, str);
+}
+
+void Utf8Decoder::decode(const void* data, size_t len, std::u32string* str) {
+    assert(str);
+    decodeChunk(buf_, &len_, static_cast<const unsigned char*>(data), len, str);
+}
+
+size_t Utf8Decoder::decode(const void* data, size_t len, char16_t* d) {
+    assert(d);
+    return decodeChunk(
+        buf_, &len_, static_cast<const unsigned char*>(data), len, d);
+}
+
+size_t Utf8Decoder::decode(const void* data, size_t len, char32_t* d) {
+    assert(d);
+    return decodeChunk(
+        buf_, &len_, static_cast<const unsigned char*>(data), len, d);
+}
+
+void Utf8Decoder::flush(std::u16string* str) {
+    assert(str);
+    if (len_) str->push_back(static_cast<char16_t>(REPLACEMENT_CHAR));
+    len_ = 0;
+}
+
+void Utf8Decoder::flush(std::u32string* str) {
+    assert(str);
+    if (len_) str->push_back(REPLACEMENT_CHAR);
+    len_ = 0;
+}
+
+bool Utf8Decoder::pending() const {
+    return len_ != 0;
+}
+
+void Utf8Decoder::reset() {
+    len_ = 0;
+}
+
 #ifdef LIBJ_USE_ICONV
 
 #ifdef LIBJ_CVTUTF_DEBUG
@@ -311,6 +701,8 @@ std::string fromUtf8(const std::string& str, UnicodeEncoding enc) {
 std::string fromUtf16(const std::u16string& str, UnicodeEncoding enc) {
     assert(sizeof(char) == 1 && sizeof(char16_t) == 2);
 
+    if (enc == UTF8) return utf16ToUtf8(str);
+
     std::string s;
     iconv_t cd = iconvOpenFromUtf16(enc);
     char* inBuf = reinterpret_cast<char*>(const_cast<char16_t*>(str.c_str()));
@@ -351,6 +743,10 @@ std::string fromUtf16(const std::u16string& str, UnicodeEncoding enc) {
 std::string fromUtf32(const std::u32string& str, UnicodeEncoding enc) {
     assert(sizeof(char) == 1 && sizeof(char32_t) == 4);
 
+    if (enc == UTF8) {
+        return encodeUtf8(str.c_str(), str.length(), NO_SIZE);
+    }
+
     std::string s;
     iconv_t cd = iconvOpenFromUtf32(enc);
     char* inBuf = reinterpret_cast<char*>(const_cast<char32_t*>(str.c_str()));
@@ -405,6 +801,12 @@ std::string toUtf8(
 
     if (!data) return std::string();
 
+    if (isNativeUtf16(enc)) {
+        return encodeUtf8(static_cast<const char16_t*>(data), len, max, n);
+    } else if (isNativeUtf32(enc)) {
+        return encodeUtf8(static_cast<const char32_t*>(data), len, max, n);
+    }
+
     std::string s8;
     iconv_t cd = iconvOpen(enc, "UTF-8");
     char* inBuf = static_cast<char*>(const_cast<void*>(data));
@@ -444,6 +846,11 @@ std::u16string toUtf16(
 
     if (!data) return std::u16string();
 
+    if (enc == UTF8) {
+        return decodeUtf8<char16_t>(
+            static_cast<const unsigned char*>(data), len, max);
+    }
+
     std::u16string s16;
     iconv_t cd = iconvOpenToUtf16(enc);
     char* inBuf = static_cast<char*>(const_cast<void*>(data));
@@ -484,6 +891,11 @@ std::u32string toUtf32(
 
     if (!data) return std::u32string();
 
+    if (enc == UTF8) {
+        return decodeUtf8<char32_t>(
+            static_cast<const unsigned char*>(data), len, max);
+    }
+
     std::u32string s32;
     iconv_t cd = iconvOpenToUtf32(enc);
     char* inBuf = static_cast<char*>(const_cast<void*>(data));
@@ -517,38 +929,11 @@ std::u32string toUtf32(
 std::u16string utf8ToUtf16(const std::string& str, size_t* n) {
     assert(sizeof(char) == 1 && sizeof(char16_t) == 2);
 
-    std::u16string s;
-    iconv_t cd;
-    if (isBigEndian()) {
-        cd = iconvOpen("UTF-8", UTF16BE);
-    } else {
-        cd = iconvOpen("UTF-8", UTF16LE);
-    }
-    char* inBuf = const_cast<char*>(str.c_str());
-    size_t inLen = str.length();
-    size_t num = 0;
-    for (size_t i = 0; i < inLen;) {
-        size_t byteLen = byteLengthAt(inBuf, UTF8);
-        size_t inBytesLeft = byteLen;
-        union {
-            char16_t c16[2];
-            char c8[4];
-        } u;
-        char* outBuf = u.c8;
-        size_t outBytesLeft = 4;
-        ICONV(cd, &inBuf, &inBytesLeft, &outBuf, &outBytesLeft);
-        assert(outBytesLeft < 4);
-        size_t outLen = (4 - outBytesLeft) >> 1;
-        for (size_t j = 0; j < outLen; j++) {
-            s += u.c16[j];
-        }
-        i += byteLen;
-        num++;
-    }
-    iconvClose(cd);
-
-    if (n) *n = num;
-    return s;
+    return decodeUtf8<char16_t>(
+        reinterpret_cast<const unsigned char*>(str.c_str()),
+        str.length(),
+        NO_SIZE,
+        n);
 }
 
 std::u16string utf32ToUtf16(const std::u32string& str) {
@@ -720,30 +1105,7 @@ static std::u16string utf8ToUtf16(
     size_t* n = NULL) {
     assert(data && sizeof(unsigned char) == 1 && sizeof(char16_t) == 2);
 
-    const unsigned char* end;
-    size_t num = findUtf8End(data, len, max, &end);
-    if (n) *n = num;
-    if (!num) return std::u16string();
-
-    const unsigned char* sourceStart = data;
-    const unsigned char* sourceEnd = end;
-
-    num <<= 1;
-    char16_t* out = new char16_t[num];
-    char16_t* targetStart = out;
-    char16_t* targetEnd = out + num;
-
-    ConvertUTF8toUTF16(
-        &sourceStart,
-        sourceEnd,
-        &targetStart,
-        targetEnd,
-        strictConversion);
-
-    num = targetStart - out;
-    std::u16string u16s(out, num);
-    delete[] out;
-    return u16s;
+    return decodeUtf8<char16_t>(data, len, max, n);
 }
 
 static std::u32string utf8ToUtf32(
@@ -752,27 +1114,7 @@ static std::u32string utf8ToUtf32(
     size_t max) {
     assert(data && sizeof(unsigned char) == 1 && sizeof(char32_t) == 4);
 
-    const unsigned char* end;
-    size_t n = findUtf8End(data, len, max, &end);
-    if (!n) return std::u32string();
-
-    const unsigned char* sourceStart = data;
-    const unsigned char* sourceEnd = end;
-
-    char32_t* out = new char32_t[n];
-    char32_t* targetStart = out;
-    char32_t* targetEnd = out + n;
-
-    ConvertUTF8toUTF32(
-        &sourceStart,
-        sourceEnd,
-        &targetStart,
-        targetEnd,
-        strictConversion);
-
-    std::u32string u32s(out, targetStart - out);
-    delete[] out;
-    return u32s;
+    return decodeUtf8<char32_t>(data, len, max);
 }
 
 static std::string utf16ToUtf8(
@@ -783,6 +1125,8 @@ static std::string utf16ToUtf8(
     size_t* n = NULL) {
     assert(data && sizeof(unsigned char) == 1 && sizeof(char16_t) == 2);
 
+    if (!needsSwap(enc)) return encodeUtf8(data, len, max, n);
+
     const char16_t* end;
     std::u16string* u16s;
     size_t num = findUtf16End(data, enc, len, max, &end, &u16s);
@@ -907,6 +1251,8 @@ static std::string utf32ToUtf8(
     size_t* n = NULL) {
     assert(data && sizeof(unsigned char) == 1 && sizeof(char32_t) == 4);
 
+    if (!needsSwap(enc)) return encodeUtf8(data, len, max, n);
+
     const char32_t* end;
     std::u32string* u32s;
     size_t num = findUtf32End(data, enc, len, max, &end, &u32s);
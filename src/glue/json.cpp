@@ -80,25 +80,25 @@ class JsonHandler {
         return root_;
     }
 
-    void add(const Value& v) {
+    void add(Value v) {
         if (array_) {
-            array_->add(v);
+            array_->add(LIBJ_MOVE(v));
         } else if (object_) {
             assert(name_);
-            object_->put(name_, v);
+            object_->put(LIBJ_MOVE(name_), LIBJ_MOVE(v));
             name_ = String::null();
         } else {
             assert(root_.isUndefined());
-            root_ = v;
+            root_ = LIBJ_MOVE(v);
         }
     }
 
     void push() {
         if (array_) {
-            stack_->push(array_);
+            stack_->push(LIBJ_MOVE(array_));
             array_ = JsArray::null();
         } else if (object_) {
-            stack_->push(object_);
+            stack_->push(LIBJ_MOVE(object_));
             object_ = JsObject::null();
         }
     }
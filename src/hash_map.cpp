@@ -0,0 +1,12 @@
+// Copyright (c) 2013 Plenluno All rights reserved.
+
+#include <libj/hash_map.h>
+#include <libj/detail/hash_map.h>
+
+namespace libj {
+
+HashMap::Ptr HashMap::create() {
+    return Ptr(new detail::HashMap<HashMap>());
+}
+
+}  // namespace libj
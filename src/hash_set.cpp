@@ -0,0 +1,12 @@
+// Copyright (c) 2013 Plenluno All rights reserved.
+
+#include <libj/hash_set.h>
+#include <libj/detail/hash_set.h>
+
+namespace libj {
+
+HashSet::Ptr HashSet::create() {
+    return Ptr(new detail::HashSet<HashSet>());
+}
+
+}  // namespace libj
@@ -137,7 +137,7 @@ String::CPtr stringify(const Value& val) {
         return String::null();
     } else {
         StringBuilder::Ptr sb = StringBuilder::create();
-        return stringify(val, sb)->toString();
+        return stringify(val, sb)->build();
     }
 }
 
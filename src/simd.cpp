@@ -0,0 +1,240 @@
+// Copyright (c) 2013 Plenluno All rights reserved.
+
+#include "./simd_kernel.h"
+
+#ifdef __SSE2__
+# include <emmintrin.h>
+# include <string.h>
+#endif
+
+namespace libj {
+namespace detail {
+namespace simd {
+
+#ifdef LIBJ_USE_AVX2
+Kernels avx2Kernels();
+#endif
+
+namespace {
+
+#ifdef __SSE2__
+
+struct Sse2Base {
+    typedef __m128i V;
+
+    static const Size BYTES = 16;
+
+    struct Scope {
+        Scope() {}
+    };
+
+    static V load(const void* p) {
+        return _mm_loadu_si128(static_cast<const V*>(p));
+    }
+
+    static void store(void* p, V v) {
+        _mm_storeu_si128(static_cast<V*>(p), v);
+    }
+
+    static V and_(V a, V b) {
+        return _mm_and_si128(a, b);
+    }
+
+    // returns m ? a : b for each element
+    static V blend(V m, V a, V b) {
+        return _mm_or_si128(_mm_and_si128(m, a), _mm_andnot_si128(m, b));
+    }
+
+    static UInt mask(V v) {
+        return _mm_movemask_epi8(v);
+    }
+
+    static UInt firstBit(UInt m) {
+        return __builtin_ctz(m);
+    }
+
+    static UInt lastBit(UInt m) {
+        return 31 - __builtin_clz(m);
+    }
+};
+
+template<Size N>
+struct Sse2;
+
+template<>
+struct Sse2<1> : Sse2Base {
+    static V set1(UInt c) { return _mm_set1_epi8(static_cast<char>(c)); }
+    static V eq(V a, V b) { return _mm_cmpeq_epi8(a, b); }
+    static V add(V a, V b) { return _mm_add_epi8(a, b); }
+    static V sub(V a, V b) { return _mm_sub_epi8(a, b); }
+
+    // unsigned a <= b
+    static V le(V a, V b) {
+        return _mm_cmpeq_epi8(_mm_subs_epu8(a, b), _mm_setzero_si128());
+    }
+
+    static void widen(V v, char16_t* d) {
+        V zero = _mm_setzero_si128();
+        store(d, _mm_unpacklo_epi8(v, zero));
+        store(d + 8, _mm_unpackhi_epi8(v, zero));
+    }
+
+    static void widen(V v, char32_t* d) {
+        V zero = _mm_setzero_si128();
+        V lo = _mm_unpacklo_epi8(v, zero);
+        V hi = _mm_unpackhi_epi8(v, zero);
+        store(d, _mm_unpacklo_epi16(lo, zero));
+        store(d + 4, _mm_unpackhi_epi16(lo, zero));
+        store(d + 8, _mm_unpacklo_epi16(hi, zero));
+        store(d + 12, _mm_unpackhi_epi16(hi, zero));
+    }
+};
+
+template<>
+struct Sse2<2> : Sse2Base {
+    static V set1(UInt c) { return _mm_set1_epi16(static_cast<short>(c)); }
+    static V eq(V a, V b) { return _mm_cmpeq_epi16(a, b); }
+    static V add(V a, V b) { return _mm_add_epi16(a, b); }
+    static V sub(V a, V b) { return _mm_sub_epi16(a, b); }
+
+    static V le(V a, V b) {
+        return _mm_cmpeq_epi16(_mm_subs_epu16(a, b), _mm_setzero_si128());
+    }
+
+    // only the lanes in [0, 0xff] are narrowed correctly
+    static void narrow(V v, UByte* d) {
+        _mm_storel_epi64(reinterpret_cast<V*>(d), _mm_packus_epi16(v, v));
+    }
+};
+
+template<>
+struct Sse2<4> : Sse2Base {
+    static V set1(UInt c) { return _mm_set1_epi32(static_cast<int>(c)); }
+    static V eq(V a, V b) { return _mm_cmpeq_epi32(a, b); }
+    static V add(V a, V b) { return _mm_add_epi32(a, b); }
+    static V sub(V a, V b) { return _mm_sub_epi32(a, b); }
+
+    // SSE2 has no unsigned comparison of 32-bit integers
+    static V le(V a, V b) {
+        V bias = _mm_set1_epi32(static_cast<int>(0x80000000));
+        V gt = _mm_cmpgt_epi32(_mm_xor_si128(a, bias), _mm_xor_si128(b, bias));
+        return _mm_andnot_si128(gt, _mm_set1_epi32(-1));
+    }
+
+    // only the lanes in [0, 0x7fff] are narrowed correctly
+    static void narrow(V v, UByte* d) {
+        V v16 = _mm_packs_epi32(v, v);
+        UInt u = _mm_cvtsi128_si32(_mm_packus_epi16(v16, v16));
+        memcpy(d, &u, sizeof(u));
+    }
+};
+
+#else  // __SSE2__
+
+Kernels scalarKernels() {
+    Kernels k = {
+        findScalar<Char>,
+        findLastScalar<UByte>,
+        findLastScalar<Char>,
+        findRangeScalar<UByte>,
+        findRangeScalar<Char>,
+        findPairScalar<UByte>,
+        findPairScalar<Char>,
+        copyAsciiScalar<UByte, char16_t>,
+        copyAsciiScalar<UByte, char32_t>,
+        copyAsciiScalar<char16_t, UByte>,
+        copyAsciiScalar<char32_t, UByte>,
+        replaceScalar<UByte>,
+        replaceScalar<Char>,
+        shiftRangeScalar<UByte>,
+        shiftRangeScalar<Char>,
+    };
+    return k;
+}
+
+#endif  // __SSE2__
+
+Kernels select() {
+#ifdef LIBJ_USE_AVX2
+    // kernels() may run first in a static initializer,
+    // before libgcc has detected the cpu
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) return avx2Kernels();
+#endif
+#ifdef __SSE2__
+    return VectorKernels<Sse2>::create();
+#else
+    return scalarKernels();
+#endif
+}
+
+const Kernels& kernels() {
+    static const Kernels k = select();
+    return k;
+}
+
+}  // namespace
+
+Size find(const Char* s, Size n, Char c) {
+    return kernels().find(s, n, c);
+}
+
+Size findLast(const UByte* s, Size n, UByte c) {
+    return kernels().findLast8(s, n, c);
+}
+
+Size findLast(const Char* s, Size n, Char c) {
+    return kernels().findLast(s, n, c);
+}
+
+Size findRange(const UByte* s, Size n, UByte lo, UByte hi) {
+    return kernels().findRange8(s, n, lo, hi);
+}
+
+Size findRange(const Char* s, Size n, Char lo, Char hi) {
+    return kernels().findRange(s, n, lo, hi);
+}
+
+Size findPair(const UByte* s, Size n, UByte first, UByte last, Size gap) {
+    return kernels().findPair8(s, n, first, last, gap);
+}
+
+Size findPair(const Char* s, Size n, Char first, Char last, Size gap) {
+    return kernels().findPair(s, n, first, last, gap);
+}
+
+Size widenAscii(const UByte* s, Size n, char16_t* d) {
+    return kernels().widenAscii16(s, n, d);
+}
+
+Size widenAscii(const UByte* s, Size n, char32_t* d) {
+    return kernels().widenAscii32(s, n, d);
+}
+
+Size narrowAscii(const char16_t* s, Size n, UByte* d) {
+    return kernels().narrowAscii16(s, n, d);
+}
+
+Size narrowAscii(const char32_t* s, Size n, UByte* d) {
+    return kernels().narrowAscii32(s, n, d);
+}
+
+void replace(UByte* s, Size n, UByte oldC, UByte newC) {
+    kernels().replace8(s, n, oldC, newC);
+}
+
+void replace(Char* s, Size n, Char oldC, Char newC) {
+    kernels().replace(s, n, oldC, newC);
+}
+
+void shiftRange(UByte* s, Size n, UByte lo, UByte hi, Int diff) {
+    kernels().shiftRange8(s, n, lo, hi, diff);
+}
+
+void shiftRange(Char* s, Size n, Char lo, Char hi, Int diff) {
+    kernels().shiftRange(s, n, lo, hi, diff);
+}
+
+}  // namespace simd
+}  // namespace detail
+}  // namespace libj
@@ -0,0 +1,135 @@
+// Copyright (c) 2013 Plenluno All rights reserved.
+
+// compiled with -mavx2 and used only if the cpu supports AVX2
+
+#include "./simd_kernel.h"
+
+#include <immintrin.h>
+
+namespace libj {
+namespace detail {
+namespace simd {
+
+namespace {
+
+struct Avx2Base {
+    typedef __m256i V;
+
+    static const Size BYTES = 32;
+
+    // avoids the penalty of SSE instructions after AVX ones,
+    // which the compiler does not do when it optimizes little
+    struct Scope {
+        ~Scope() { _mm256_zeroupper(); }
+    };
+
+    static V load(const void* p) {
+        return _mm256_loadu_si256(static_cast<const V*>(p));
+    }
+
+    static void store(void* p, V v) {
+        _mm256_storeu_si256(static_cast<V*>(p), v);
+    }
+
+    static V and_(V a, V b) {
+        return _mm256_and_si256(a, b);
+    }
+
+    // returns m ? a : b for each element
+    static V blend(V m, V a, V b) {
+        return _mm256_blendv_epi8(b, a, m);
+    }
+
+    static UInt mask(V v) {
+        return _mm256_movemask_epi8(v);
+    }
+
+    static UInt firstBit(UInt m) {
+        return __builtin_ctz(m);
+    }
+
+    static UInt lastBit(UInt m) {
+        return 31 - __builtin_clz(m);
+    }
+};
+
+template<Size N>
+struct Avx2;
+
+template<>
+struct Avx2<1> : Avx2Base {
+    static V set1(UInt c) { return _mm256_set1_epi8(static_cast<char>(c)); }
+    static V eq(V a, V b) { return _mm256_cmpeq_epi8(a, b); }
+    static V add(V a, V b) { return _mm256_add_epi8(a, b); }
+    static V sub(V a, V b) { return _mm256_sub_epi8(a, b); }
+
+    // unsigned a <= b
+    static V le(V a, V b) {
+        return _mm256_cmpeq_epi8(_mm256_min_epu8(a, b), a);
+    }
+
+    static void widen(V v, char16_t* d) {
+        store(d, _mm256_cvtepu8_epi16(_mm256_castsi256_si128(v)));
+        store(d + 16, _mm256_cvtepu8_epi16(_mm256_extracti128_si256(v, 1)));
+    }
+
+    static void widen(V v, char32_t* d) {
+        __m128i lo = _mm256_castsi256_si128(v);
+        __m128i hi = _mm256_extracti128_si256(v, 1);
+        store(d, _mm256_cvtepu8_epi32(lo));
+        store(d + 8, _mm256_cvtepu8_epi32(_mm_srli_si128(lo, 8)));
+        store(d + 16, _mm256_cvtepu8_epi32(hi));
+        store(d + 24, _mm256_cvtepu8_epi32(_mm_srli_si128(hi, 8)));
+    }
+};
+
+template<>
+struct Avx2<2> : Avx2Base {
+    static V set1(UInt c) { return _mm256_set1_epi16(static_cast<short>(c)); }
+    static V eq(V a, V b) { return _mm256_cmpeq_epi16(a, b); }
+    static V add(V a, V b) { return _mm256_add_epi16(a, b); }
+    static V sub(V a, V b) { return _mm256_sub_epi16(a, b); }
+
+    static V le(V a, V b) {
+        return _mm256_cmpeq_epi16(_mm256_min_epu16(a, b), a);
+    }
+
+    // only the lanes in [0, 0xff] are narrowed correctly
+    static void narrow(V v, UByte* d) {
+        V p = _mm256_permute4x64_epi64(_mm256_packus_epi16(v, v), 0x08);
+        _mm_storeu_si128(
+            reinterpret_cast<__m128i*>(d), _mm256_castsi256_si128(p));
+    }
+};
+
+template<>
+struct Avx2<4> : Avx2Base {
+    static V set1(UInt c) { return _mm256_set1_epi32(static_cast<int>(c)); }
+    static V eq(V a, V b) { return _mm256_cmpeq_epi32(a, b); }
+    static V add(V a, V b) { return _mm256_add_epi32(a, b); }
+    static V sub(V a, V b) { return _mm256_sub_epi32(a, b); }
+
+    static V le(V a, V b) {
+        return _mm256_cmpeq_epi32(_mm256_min_epu32(a, b), a);
+    }
+
+    // only the lanes in [0, 0x7fff] are narrowed correctly
+    static void narrow(V v, UByte* d) {
+        V v16 = _mm256_packs_epi32(v, v);
+        V v8 = _mm256_packus_epi16(v16, v16);
+        V idx = _mm256_setr_epi32(0, 4, 0, 0, 0, 0, 0, 0);
+        V p = _mm256_permutevar8x32_epi32(v8, idx);
+        _mm_storel_epi64(
+            reinterpret_cast<__m128i*>(d), _mm256_castsi256_si128(p));
+    }
+};
+
+}  // namespace
+
+Kernels avx2Kernels() {
+    return VectorKernels<Avx2>::create();
+}
+
+}  // namespace simd
+}  // namespace detail
+}  // namespace libj
@@ -0,0 +1,257 @@
+// Copyright (c) 2013 Plenluno All rights reserved.
+
+#ifndef LIBJ_SRC_SIMD_KERNEL_H_
+#define LIBJ_SRC_SIMD_KERNEL_H_
+
+#include <libj/detail/simd.h>
+
+// the kernels are static so that every translation unit,
+// compiled for its own instruction set, keeps its own copy.
+// for the same reason, this header includes as little as possible.
+//
+// O is a set of vector operations on elements of sizeof(C) bytes:
+//   V, BYTES, Scope, load, store, set1, eq, add, sub, and_, blend, le,
+//   mask, firstBit and lastBit,
+// and widen for 1-byte elements or narrow for the others.
+// a Scope lives as long as a kernel runs, to clean up the vector state.
+
+namespace libj {
+namespace detail {
+namespace simd {
+
+// the same as NO_POS
+static const Size NOT_FOUND = static_cast<Size>(-1);
+
+struct Kernels {
+    Size (*find)(const Char*, Size, Char);
+    Size (*findLast8)(const UByte*, Size, UByte);
+    Size (*findLast)(const Char*, Size, Char);
+    Size (*findRange8)(const UByte*, Size, UByte, UByte);
+    Size (*findRange)(const Char*, Size, Char, Char);
+    Size (*findPair8)(const UByte*, Size, UByte, UByte, Size);
+    Size (*findPair)(const Char*, Size, Char, Char, Size);
+    Size (*widenAscii16)(const UByte*, Size, char16_t*);
+    Size (*widenAscii32)(const UByte*, Size, char32_t*);
+    Size (*narrowAscii16)(const char16_t*, Size, UByte*);
+    Size (*narrowAscii32)(const char32_t*, Size, UByte*);
+    void (*replace8)(UByte*, Size, UByte, UByte);
+    void (*replace)(Char*, Size, Char, Char);
+    void (*shiftRange8)(UByte*, Size, UByte, UByte, Int);
+    void (*shiftRange)(Char*, Size, Char, Char, Int);
+};
+
+template<typename C>
+static Size findScalar(const C* s, Size n, C c) {
+    for (Size i = 0; i < n; i++) {
+        if (s[i] == c) return i;
+    }
+    return NOT_FOUND;
+}
+
+template<typename C>
+static Size findLastScalar(const C* s, Size n, C c) {
+    while (n-- > 0) {
+        if (s[n] == c) return n;
+    }
+    return NOT_FOUND;
+}
+
+template<typename C>
+static Size findRangeScalar(const C* s, Size n, C lo, C hi) {
+    C span = hi - lo;
+    for (Size i = 0; i < n; i++) {
+        if (static_cast<C>(s[i] - lo) <= span) return i;
+    }
+    return NOT_FOUND;
+}
+
+template<typename C>
+static Size findPairScalar(const C* s, Size n, C first, C last, Size gap) {
+    for (Size i = 0; i < n; i++) {
+        if (s[i] == first && s[i + gap] == last) return i;
+    }
+    return NOT_FOUND;
+}
+
+template<typename C, typename D>
+static Size copyAsciiScalar(const C* s, Size n, D* d) {
+    for (Size i = 0; i < n; i++) {
+        if (static_cast<UInt>(s[i]) - 1 >= 0x7f) return i;
+        d[i] = static_cast<D>(s[i]);
+    }
+    return n;
+}
+
+template<typename C>
+static void replaceScalar(C* s, Size n, C oldC, C newC) {
+    for (Size i = 0; i < n; i++) {
+        if (s[i] == oldC) s[i] = newC;
+    }
+}
+
+template<typename C>
+static void shiftRangeScalar(C* s, Size n, C lo, C hi, Int diff) {
+    C span = hi - lo;
+    for (Size i = 0; i < n; i++) {
+        if (static_cast<C>(s[i] - lo) <= span) {
+            s[i] = static_cast<C>(s[i] + diff);
+        }
+    }
+}
+
+template<typename O, typename C>
+static Size findVector(const C* s, Size n, C c) {
+    typename O::Scope scope;
+    const Size lanes = O::BYTES / sizeof(C);
+    typename O::V vc = O::set1(c);
+    Size i = 0;
+    for (; i + lanes <= n; i += lanes) {
+        UInt m = O::mask(O::eq(O::load(s + i), vc));
+        if (m) return i + O::firstBit(m) / sizeof(C);
+    }
+    Size j = findScalar(s + i, n - i, c);
+    return j == NOT_FOUND ? NOT_FOUND : i + j;
+}
+
+template<typename O, typename C>
+static Size findLastVector(const C* s, Size n, C c) {
+    typename O::Scope scope;
+    const Size lanes = O::BYTES / sizeof(C);
+    typename O::V vc = O::set1(c);
+    Size i = n;
+    while (i >= lanes) {
+        i -= lanes;
+        UInt m = O::mask(O::eq(O::load(s + i), vc));
+        if (m) return i + O::lastBit(m) / sizeof(C);
+    }
+    return findLastScalar(s, i, c);
+}
+
+template<typename O, typename C>
+static Size findRangeVector(const C* s, Size n, C lo, C hi) {
+    typename O::Scope scope;
+    const Size lanes = O::BYTES / sizeof(C);
+    typename O::V vlo = O::set1(lo);
+    typename O::V vspan = O::set1(hi - lo);
+    Size i = 0;
+    for (; i + lanes <= n; i += lanes) {
+        typename O::V v = O::sub(O::load(s + i), vlo);
+        UInt m = O::mask(O::le(v, vspan));
+        if (m) return i + O::firstBit(m) / sizeof(C);
+    }
+    Size j = findRangeScalar(s + i, n - i, lo, hi);
+    return j == NOT_FOUND ? NOT_FOUND : i + j;
+}
+
+template<typename O, typename C>
+static Size findPairVector(const C* s, Size n, C first, C last, Size gap) {
+    typename O::Scope scope;
+    const Size lanes = O::BYTES / sizeof(C);
+    typename O::V vf = O::set1(first);
+    typename O::V vl = O::set1(last);
+    Size i = 0;
+    for (; i + lanes <= n; i += lanes) {
+        typename O::V f = O::eq(O::load(s + i), vf);
+        typename O::V l = O::eq(O::load(s + i + gap), vl);
+        UInt m = O::mask(O::and_(f, l));
+        if (m) return i + O::firstBit(m) / sizeof(C);
+    }
+    Size j = findPairScalar(s + i, n - i, first, last, gap);
+    return j == NOT_FOUND ? NOT_FOUND : i + j;
+}
+
+// lanes of v in [1, 0x7f]
+template<typename O>
+static typename O::V asciiLanes(typename O::V v) {
+    return O::le(O::sub(v, O::set1(1)), O::set1(0x7e));
+}
+
+template<typename O, typename D>
+static Size widenAsciiVector(const UByte* s, Size n, D* d) {
+    typename O::Scope scope;
+    typename O::V zero = O::set1(0);
+    Size i = 0;
+    for (; i + O::BYTES <= n; i += O::BYTES) {
+        typename O::V v = O::load(s + i);
+        O::widen(v, d + i);
+        UInt m = O::mask(O::eq(asciiLanes<O>(v), zero));
+        if (m) return i + O::firstBit(m);
+    }
+    return i + copyAsciiScalar(s + i, n - i, d + i);
+}
+
+template<typename O, typename C>
+static Size narrowAsciiVector(const C* s, Size n, UByte* d) {
+    typename O::Scope scope;
+    const Size lanes = O::BYTES / sizeof(C);
+    typename O::V zero = O::set1(0);
+    Size i = 0;
+    for (; i + lanes <= n; i += lanes) {
+        typename O::V v = O::load(s + i);
+        O::narrow(v, d + i);
+        UInt m = O::mask(O::eq(asciiLanes<O>(v), zero));
+        if (m) return i + O::firstBit(m) / sizeof(C);
+    }
+    return i + copyAsciiScalar(s + i, n - i, d + i);
+}
+
+template<typename O, typename C>
+static void replaceVector(C* s, Size n, C oldC, C newC) {
+    typename O::Scope scope;
+    const Size lanes = O::BYTES / sizeof(C);
+    typename O::V vold = O::set1(oldC);
+    typename O::V vnew = O::set1(newC);
+    Size i = 0;
+    for (; i + lanes <= n; i += lanes) {
+        typename O::V v = O::load(s + i);
+        O::store(s + i, O::blend(O::eq(v, vold), vnew, v));
+    }
+    replaceScalar(s + i, n - i, oldC, newC);
+}
+
+template<typename O, typename C>
+static void shiftRangeVector(C* s, Size n, C lo, C hi, Int diff) {
+    typename O::Scope scope;
+    const Size lanes = O::BYTES / sizeof(C);
+    typename O::V vlo = O::set1(lo);
+    typename O::V vspan = O::set1(hi - lo);
+    typename O::V vdiff = O::set1(static_cast<C>(diff));
+    Size i = 0;
+    for (; i + lanes <= n; i += lanes) {
+        typename O::V v = O::load(s + i);
+        typename O::V m = O::le(O::sub(v, vlo), vspan);
+        O::store(s + i, O::add(v, O::and_(m, vdiff)));
+    }
+    shiftRangeScalar(s + i, n - i, lo, hi, diff);
+}
+
+// O is a template of the operations on elements of each size
+template<template<Size> class O>
+struct VectorKernels {
+    static Kernels create() {
+        Kernels k = {
+            findVector<O<sizeof(Char)>, Char>,
+            findLastVector<O<1>, UByte>,
+            findLastVector<O<sizeof(Char)>, Char>,
+            findRangeVector<O<1>, UByte>,
+            findRangeVector<O<sizeof(Char)>, Char>,
+            findPairVector<O<1>, UByte>,
+            findPairVector<O<sizeof(Char)>, Char>,
+            widenAsciiVector<O<1>, char16_t>,
+            widenAsciiVector<O<1>, char32_t>,
+            narrowAsciiVector<O<2>, char16_t>,
+            narrowAsciiVector<O<4>, char32_t>,
+            replaceVector<O<1>, UByte>,
+            replaceVector<O<sizeof(Char)>, Char>,
+            shiftRangeVector<O<1>, UByte>,
+            shiftRangeVector<O<sizeof(Char)>, Char>,
+        };
+        return k;
+    }
+};
+
+}  // namespace simd
+}  // namespace detail
+}  // namespace libj
+
+#endif  // LIBJ_SRC_SIMD_KERNEL_H_
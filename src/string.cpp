@@ -2,10 +2,57 @@
 
 #include <libj/symbol.h>
 #include <libj/detail/string.h>
+#include <libj/detail/to_number.h>
 #include <libj/detail/to_string.h>
 
 namespace libj {
 
+namespace {
+
+struct ParseInt {
+    Int radix;
+    Double result;
+
+    template<typename C>
+    void operator()(const C* s, Size n) {
+        result = detail::parseInt(s, n, radix);
+    }
+};
+
+struct ParseFloat {
+    Double result;
+
+    template<typename C>
+    void operator()(const C* s, Size n) {
+        result = detail::parseFloat(s, n);
+    }
+};
+
+struct ToNumber {
+    Double result;
+
+    template<typename C>
+    void operator()(const C* s, Size n) {
+        result = detail::toNumber(s, n);
+    }
+};
+
+struct ParseLong {
+    Long* out;
+    Boolean result;
+
+    template<typename C>
+    void operator()(const C* s, Size n) {
+        result = detail::parseLong(s, n, out);
+    }
+};
+
+inline const detail::String* toDetail(String::CPtr str) {
+    return static_cast<const detail::String*>(&(*str));
+}
+
+}  // namespace
+
 String::CPtr String::create() {
     static const CPtr empty(intern(CPtr(new detail::String())));
     return empty;
@@ -48,8 +95,8 @@ String::CPtr String::create(
     }
 }
 
-String::CPtr String::intern(String::CPtr str) {
-    return detail::String::intern(str);
+String::CPtr String::intern(String::CPtr str, Boolean weak) {
+    return detail::String::intern(str, weak);
 }
 
 String::CPtr String::intern(
@@ -83,4 +130,38 @@ String::CPtr String::valueOf(const Value& val) {
     }
 }
 
+Double parseInt(String::CPtr str, Int radix) {
+    if (!str) return QUIET_NAN;
+
+    ParseInt f;
+    f.radix = radix;
+    toDetail(str)->visitChars(&f);
+    return f.result;
+}
+
+Double parseFloat(String::CPtr str) {
+    if (!str) return QUIET_NAN;
+
+    ParseFloat f;
+    toDetail(str)->visitChars(&f);
+    return f.result;
+}
+
+Double toNumber(String::CPtr str) {
+    if (!str) return QUIET_NAN;
+
+    ToNumber f;
+    toDetail(str)->visitChars(&f);
+    return f.result;
+}
+
+Boolean parseLong(String::CPtr str, Long* out) {
+    if (!str) return false;
+
+    ParseLong f;
+    f.out = out;
+    toDetail(str)->visitChars(&f);
+    return f.result;
+}
+
 }  // namespace libj
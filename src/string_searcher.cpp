@@ -0,0 +1,14 @@
+// Copyright (c) 2013 Plenluno All rights reserved.
+
+#include <libj/string_searcher.h>
+#include <libj/detail/string_searcher.h>
+
+namespace libj {
+
+StringSearcher::CPtr StringSearcher::create(String::CPtr pattern) {
+    if (!pattern) return null();
+
+    return CPtr(new detail::StringSearcher<StringSearcher>(pattern));
+}
+
+}  // namespace libj
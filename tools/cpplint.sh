@@ -1,2 +1,2 @@
 #!/bin/sh
-tools/cpplint/cpplint.py --filter=-runtime/int,-runtime/explicit,-runtime/references,-runtime/sizeof,-readability/streams,-build/include_order,-build/include_what_you_use --prefix=libj `find include src btest gtest -type f`
+tools/cpplint/cpplint.py --filter=-runtime/int,-runtime/explicit,-runtime/references,-runtime/sizeof,-readability/streams,-build/include_order,-build/include_what_you_use --prefix=libj `find include src btest gtest bench -type f`